@@ -1,6 +1,7 @@
 #include "InteractableObject.h"
 #include "../Components/NeedsComponent.h"
-#include "TimerManager.h"
+#include "../Subsystems/InteractableRegistrySubsystem.h"
+#include "../Subsystems/InteractionSchedulerSubsystem.h"
 
 AInteractableObject::AInteractableObject()
 {
@@ -23,6 +24,32 @@ void AInteractableObject::BeginPlay()
     Super::BeginPlay();
     
     TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &AInteractableObject::OnTriggerBeginOverlap);
+    
+    if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+    {
+        Registry->RegisterInteractable(this);
+    }
+}
+
+void AInteractableObject::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+    {
+        Registry->UnregisterInteractable(this);
+    }
+    
+    // Черга до цього об'єкта вже не дійде - NPC мають обрати щось інше
+    TArray<FReservationRequest> Queue = MoveTemp(ReservationQueue);
+    ReservationQueue.Reset();
+    for (FReservationRequest& Request : Queue)
+    {
+        if (Request.User.IsValid())
+        {
+            Request.OnFailed.ExecuteIfBound(this);
+        }
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void AInteractableObject::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, 
@@ -37,32 +64,54 @@ void AInteractableObject::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedC
 
 void AInteractableObject::StartInteraction(AActor* User)
 {
-    if (bIsOccupied || !User)
+    BeginInteraction(User, User ? User->FindComponentByClass<UNeedsComponent>() : nullptr, FOnInteractionFinished());
+}
+
+void AInteractableObject::BeginInteraction(AActor* User, UNeedsComponent* UserNeeds, FOnInteractionFinished&& OnFinished)
+{
+    if (!User || !CanUserInteract(User))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Cannot start interaction - object occupied or no user"));
+        UE_LOG(LogTemp, Warning, TEXT("Cannot start interaction - object occupied, reserved or no user"));
         return;
     }
 
-    bIsOccupied = true;
+    // Резерв виконано
+    if (ReservedBy == User)
+    {
+        ReservedBy = nullptr;
+        ReservationSerial = 0;
+    }
+
     CurrentUser = User;
+    CurrentUserNeeds = UserNeeds;
+    OnFinishedCallback = MoveTemp(OnFinished);
+    SetOccupied(true);
 
     UE_LOG(LogTemp, Log, TEXT("%s started using %s"), *User->GetName(), *GetName());
     
-    GetWorld()->GetTimerManager().SetTimer(InteractionTimerHandle, this, 
-                                          &AInteractableObject::CompleteInteraction,
-                                          InteractionDuration, false);
+    InteractionEndTime = GetWorld()->GetTimeSeconds() + InteractionDuration;
+    
+    if (UInteractionSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UInteractionSchedulerSubsystem>())
+    {
+        ScheduledSerial = Scheduler->Schedule(this, InteractionDuration);
+    }
+    else
+    {
+        CompleteInteraction();
+    }
 }
 
 void AInteractableObject::CompleteInteraction()
 {
+    ScheduledSerial = 0;
+    
     if (!CurrentUser)
     {
-        bIsOccupied = false;
+        SetOccupied(false);
         return;
     }
     
-    UNeedsComponent* NeedsComp = CurrentUser->FindComponentByClass<UNeedsComponent>();
-    if (NeedsComp)
+    if (UNeedsComponent* NeedsComp = CurrentUserNeeds.Get())
     {
         for (const FNeedModifier& Modifier : NeedModifiers)
         {
@@ -74,18 +123,156 @@ void AInteractableObject::CompleteInteraction()
 
     UE_LOG(LogTemp, Log, TEXT("%s finished using %s"), *CurrentUser->GetName(), *GetName());
     
-    OnInteractionComplete.Broadcast(CurrentUser);
+    // Як і раніше, власник дізнається про завершення, поки об'єкт ще зайнятий
+    FOnInteractionFinished OnFinished = MoveTemp(OnFinishedCallback);
+    OnFinishedCallback.Unbind();
+    OnFinished.ExecuteIfBound(this);
     
     CurrentUser = nullptr;
-    bIsOccupied = false;
+    CurrentUserNeeds = nullptr;
+    SetOccupied(false);
 }
 
-void AInteractableObject::EndInteraction()
+void AInteractableObject::CancelInteraction(AActor* User)
+{
+    ReleaseReservation(User);
+    
+    if (!User || CurrentUser != User)
+    {
+        return;
+    }
+    
+    ScheduledSerial = 0;
+    OnFinishedCallback.Unbind();
+    CurrentUser = nullptr;
+    CurrentUserNeeds = nullptr;
+    SetOccupied(false);
+}
+
+void AInteractableObject::SetOccupied(bool bOccupied)
+{
+    if (bIsOccupied == bOccupied)
+    {
+        return;
+    }
+    
+    bIsOccupied = bOccupied;
+    UpdateAvailability();
+}
+
+void AInteractableObject::UpdateAvailability()
+{
+    // Звільнений об'єкт одразу переходить до першого в черзі
+    while (!bIsOccupied && !ReservedBy && ReservationQueue.Num() > 0)
+    {
+        FReservationRequest Request = MoveTemp(ReservationQueue[0]);
+        ReservationQueue.RemoveAt(0, 1, EAllowShrinking::No);
+        
+        if (AActor* User = Request.User.Get())
+        {
+            GrantReservation(User, Request.HoldSeconds);
+            Request.OnGranted.ExecuteIfBound(this);
+        }
+    }
+    
+    const bool bFree = CanInteract();
+    if (bFree != bWasFree)
+    {
+        bWasFree = bFree;
+        OnOccupancyChanged.Broadcast(this, bFree);
+    }
+}
+
+void AInteractableObject::GrantReservation(AActor* User, float HoldSeconds)
+{
+    ReservedBy = User;
+    ReservationSerial = 0;
+    
+    if (UInteractionSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UInteractionSchedulerSubsystem>())
+    {
+        ReservationSerial = Scheduler->ScheduleReservationTimeout(this, HoldSeconds);
+    }
+}
+
+bool AInteractableObject::Reserve(AActor* User, float HoldSeconds, FOnReservationGranted&& OnGranted,
+                                  FOnReservationFailed&& OnFailed)
+{
+    if (!User)
+    {
+        return false;
+    }
+    
+    if (CanUserInteract(User))
+    {
+        GrantReservation(User, HoldSeconds);
+        UpdateAvailability();
+        return true;
+    }
+    
+    if (OnGranted.IsBound())
+    {
+        FReservationRequest& Request = ReservationQueue.AddDefaulted_GetRef();
+        Request.User = User;
+        Request.HoldSeconds = HoldSeconds;
+        Request.OnGranted = MoveTemp(OnGranted);
+        Request.OnFailed = MoveTemp(OnFailed);
+    }
+    return false;
+}
+
+void AInteractableObject::ReleaseReservation(AActor* User)
+{
+    if (!User)
+    {
+        return;
+    }
+    
+    if (ReservedBy == User)
+    {
+        ReservedBy = nullptr;
+        ReservationSerial = 0;
+        UpdateAvailability();
+        return;
+    }
+    
+    ReservationQueue.RemoveAll([User](const FReservationRequest& Request)
+    {
+        return Request.User == User;
+    });
+}
+
+void AInteractableObject::ExpireReservation()
+{
+    if (ReservedBy)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: reservation of %s timed out"), *GetName(), *ReservedBy->GetName());
+    }
+    
+    ReservedBy = nullptr;
+    ReservationSerial = 0;
+    UpdateAvailability();
+}
+
+float AInteractableObject::EstimateWaitTime() const
 {
-    if (InteractionTimerHandle.IsValid())
+    float Wait = 0.0f;
+    
+    if (bIsOccupied)
+    {
+        Wait += FMath::Max(0.0f, (float)(InteractionEndTime - GetWorld()->GetTimeSeconds()));
+    }
+    
+    // Зарезервований ще не почав взаємодію, кожен у черзі займе повну тривалість
+    if (ReservedBy)
     {
-        GetWorld()->GetTimerManager().ClearTimer(InteractionTimerHandle);
+        Wait += InteractionDuration;
     }
     
+    Wait += ReservationQueue.Num() * InteractionDuration;
+    return Wait;
+}
+
+void AInteractableObject::EndInteraction()
+{
     CompleteInteraction();
 }
\ No newline at end of file
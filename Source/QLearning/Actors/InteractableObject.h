@@ -6,7 +6,11 @@
 #include "Components/BoxComponent.h"
 #include "InteractableObject.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInteractionComplete, AActor*, User);
+// Тільки власник взаємодії отримує завершення, без фільтрації по User
+DECLARE_DELEGATE_OneParam(FOnInteractionFinished, AInteractableObject*);
+DECLARE_DELEGATE_OneParam(FOnReservationGranted, AInteractableObject*);
+DECLARE_DELEGATE_OneParam(FOnReservationFailed, AInteractableObject*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInteractableOccupancyChanged, AInteractableObject*, bool /*bFree*/);
 
 UCLASS()
 class QLEARNING_API AInteractableObject : public AActor
@@ -18,6 +22,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
@@ -35,21 +40,53 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Interaction")
     AActor* CurrentUser = nullptr;
     
+    // NPC, який уже йде до об'єкта; інші його не бачать як вільний
+    UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+    AActor* ReservedBy = nullptr;
+    
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UBoxComponent* TriggerBox;
     
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* MeshComponent;
     
-    UPROPERTY(BlueprintAssignable, Category = "Interaction")
-    FOnInteractionComplete OnInteractionComplete;
+    // Для просторових індексів вільних об'єктів
+    FOnInteractableOccupancyChanged OnOccupancyChanged;
     
+    // Вільний і не зарезервований
     UFUNCTION(BlueprintCallable, Category = "Interaction")
-    bool CanInteract() const { return !bIsOccupied; }
+    bool CanInteract() const { return !bIsOccupied && !ReservedBy; }
+
+    bool CanUserInteract(const AActor* User) const { return !bIsOccupied && (!ReservedBy || ReservedBy == User); }
+
+    // Вільний об'єкт резервується одразу (true). Інакше, якщо є OnGranted, User стає в чергу
+    // і отримає колбек, коли резерв перейде до нього. Резерв знімається через HoldSeconds.
+    // OnFailed - якщо об'єкт зникає раніше, ніж черга дійде до User
+    bool Reserve(AActor* User, float HoldSeconds, FOnReservationGranted&& OnGranted = FOnReservationGranted(),
+                 FOnReservationFailed&& OnFailed = FOnReservationFailed());
+    void ReleaseReservation(AActor* User);
+    bool IsReservedFor(const AActor* User) const { return User && ReservedBy == User; }
+    int32 GetQueueLength() const { return ReservationQueue.Num(); }
+
+    // Оцінка, через скільки секунд об'єкт звільниться для нового в черзі
+    float EstimateWaitTime() const;
+
+    void ExpireReservation();
+    uint32 GetReservationSerial() const { return ReservationSerial; }
 
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void StartInteraction(AActor* User);
 
+    // Нативний шлях для NPC: потреби вже відомі, колбек викликається тільки для User
+    void BeginInteraction(AActor* User, class UNeedsComponent* UserNeeds, FOnInteractionFinished&& OnFinished);
+
+    // Звільнити об'єкт, резерв і місце в черзі User без модифікаторів і колбека (NPC пішов у пул)
+    void CancelInteraction(AActor* User);
+
+    // Викликається UInteractionSchedulerSubsystem
+    void CompleteInteraction();
+    uint32 GetScheduledSerial() const { return ScheduledSerial; }
+
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void EndInteraction();
 
@@ -63,6 +100,24 @@ protected:
                                bool bFromSweep, const FHitResult& SweepResult);
 
 private:
-    FTimerHandle InteractionTimerHandle;
-    void CompleteInteraction();
+    struct FReservationRequest
+    {
+        TWeakObjectPtr<AActor> User;
+        float HoldSeconds = 0.0f;
+        FOnReservationGranted OnGranted;
+        FOnReservationFailed OnFailed;
+    };
+
+    void SetOccupied(bool bOccupied);
+    void UpdateAvailability();
+    void GrantReservation(AActor* User, float HoldSeconds);
+
+    TArray<FReservationRequest> ReservationQueue;
+    uint32 ReservationSerial = 0;
+    double InteractionEndTime = 0.0;
+    bool bWasFree = true;
+
+    TWeakObjectPtr<class UNeedsComponent> CurrentUserNeeds;
+    FOnInteractionFinished OnFinishedCallback;
+    uint32 ScheduledSerial = 0;
 };
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "InteractableSpatialIndex.h"
+#include "InteractableObject.h"
+
+FInteractableSpatialIndex::FInteractableSpatialIndex(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+FIntPoint FInteractableSpatialIndex::ToCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FInteractableSpatialIndex::Add(AInteractableObject* Object)
+{
+    if (!Object || Entries.Contains(Object) || Object->ActionType >= EActionType::MAX)
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries.Add(Object);
+    Entry.ActionType = Object->ActionType;
+    Entry.Location = Object->GetActorLocation();
+    Entry.Cell = ToCell(Entry.Location);
+
+    FActionGrid& Grid = Grids[(int32)Entry.ActionType];
+    Grid.MinCell = FIntPoint(FMath::Min(Grid.MinCell.X, Entry.Cell.X), FMath::Min(Grid.MinCell.Y, Entry.Cell.Y));
+    Grid.MaxCell = FIntPoint(FMath::Max(Grid.MaxCell.X, Entry.Cell.X), FMath::Max(Grid.MaxCell.Y, Entry.Cell.Y));
+
+    if (Object->CanInteract())
+    {
+        Link(Object, Entry);
+    }
+}
+
+void FInteractableSpatialIndex::Remove(AInteractableObject* Object)
+{
+    FEntry* Entry = Entries.Find(Object);
+    if (!Entry)
+    {
+        return;
+    }
+
+    Unlink(Object, *Entry);
+    Entries.Remove(Object);
+}
+
+void FInteractableSpatialIndex::Reset()
+{
+    Entries.Empty();
+    for (FActionGrid& Grid : Grids)
+    {
+        Grid = FActionGrid();
+    }
+}
+
+void FInteractableSpatialIndex::SetFree(AInteractableObject* Object, bool bFree)
+{
+    FEntry* Entry = Entries.Find(Object);
+    if (!Entry || Entry->bFree == bFree)
+    {
+        return;
+    }
+
+    if (bFree)
+    {
+        Link(Object, *Entry);
+    }
+    else
+    {
+        Unlink(Object, *Entry);
+    }
+}
+
+void FInteractableSpatialIndex::Link(AInteractableObject* Object, FEntry& Entry)
+{
+    if (Entry.bFree)
+    {
+        return;
+    }
+
+    FActionGrid& Grid = Grids[(int32)Entry.ActionType];
+    Grid.Cells.FindOrAdd(Entry.Cell).Add(Object);
+    Grid.NumFree++;
+    Entry.bFree = true;
+}
+
+void FInteractableSpatialIndex::Unlink(AInteractableObject* Object, FEntry& Entry)
+{
+    if (!Entry.bFree)
+    {
+        return;
+    }
+
+    FActionGrid& Grid = Grids[(int32)Entry.ActionType];
+    if (TArray<AInteractableObject*>* Cell = Grid.Cells.Find(Entry.Cell))
+    {
+        Cell->RemoveSingleSwap(Object, EAllowShrinking::No);
+        if (Cell->Num() == 0)
+        {
+            Grid.Cells.Remove(Entry.Cell);
+        }
+    }
+    Grid.NumFree--;
+    Entry.bFree = false;
+}
+
+int32 FInteractableSpatialIndex::NumFree(EActionType ActionType) const
+{
+    return ActionType < EActionType::MAX ? Grids[(int32)ActionType].NumFree : 0;
+}
+
+AInteractableObject* FInteractableSpatialIndex::FindNearestFree(EActionType ActionType, const FVector& Location,
+                                                                float* OutDistSquared) const
+{
+    if (ActionType >= EActionType::MAX)
+    {
+        return nullptr;
+    }
+
+    const FActionGrid& Grid = Grids[(int32)ActionType];
+    if (Grid.NumFree == 0)
+    {
+        return nullptr;
+    }
+
+    const FIntPoint Center = ToCell(Location);
+    const int32 MaxRing = FMath::Max(
+        FMath::Max(FMath::Abs(Center.X - Grid.MinCell.X), FMath::Abs(Grid.MaxCell.X - Center.X)),
+        FMath::Max(FMath::Abs(Center.Y - Grid.MinCell.Y), FMath::Abs(Grid.MaxCell.Y - Center.Y)));
+
+    AInteractableObject* Best = nullptr;
+    float BestDistSq = TNumericLimits<float>::Max();
+
+    auto VisitCell = [&](int32 X, int32 Y)
+    {
+        const TArray<AInteractableObject*>* Cell = Grid.Cells.Find(FIntPoint(X, Y));
+        if (!Cell)
+        {
+            return;
+        }
+
+        for (AInteractableObject* Object : *Cell)
+        {
+            const float DistSq = FVector::DistSquared(Location, Entries.FindChecked(Object).Location);
+            if (DistSq < BestDistSq)
+            {
+                BestDistSq = DistSq;
+                Best = Object;
+            }
+        }
+    };
+
+    for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+    {
+        if (Ring == 0)
+        {
+            VisitCell(Center.X, Center.Y);
+        }
+        else
+        {
+            for (int32 d = -Ring; d <= Ring; d++)
+            {
+                VisitCell(Center.X + d, Center.Y - Ring);
+                VisitCell(Center.X + d, Center.Y + Ring);
+            }
+            for (int32 d = -Ring + 1; d <= Ring - 1; d++)
+            {
+                VisitCell(Center.X - Ring, Center.Y + d);
+                VisitCell(Center.X + Ring, Center.Y + d);
+            }
+        }
+
+        // Будь-яка клітинка наступного кільця не ближча за Ring * CellSize
+        const float RingDist = Ring * CellSize;
+        if (Best && BestDistSq <= RingDist * RingDist)
+        {
+            break;
+        }
+    }
+
+    if (OutDistSquared)
+    {
+        *OutDistSquared = BestDistSq;
+    }
+    return Best;
+}
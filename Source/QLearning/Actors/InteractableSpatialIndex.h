@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Core/QLearningTypes.h"
+
+class AInteractableObject;
+
+// Просторовий індекс вільних об'єктів окремо для кожного EActionType.
+// Рівномірна сітка в площині XY, пошук кільцями від клітинки запиту, тільки квадрати відстаней.
+class QLEARNING_API FInteractableSpatialIndex
+{
+public:
+    explicit FInteractableSpatialIndex(float InCellSize = 1000.0f);
+
+    void Add(AInteractableObject* Object);
+    void Remove(AInteractableObject* Object);
+    void Reset();
+
+    // Викликається при зміні зайнятості об'єкта
+    void SetFree(AInteractableObject* Object, bool bFree);
+
+    AInteractableObject* FindNearestFree(EActionType ActionType, const FVector& Location,
+                                         float* OutDistSquared = nullptr) const;
+
+    bool Contains(const AInteractableObject* Object) const { return Entries.Contains(Object); }
+    int32 Num() const { return Entries.Num(); }
+    int32 NumFree(EActionType ActionType) const;
+
+private:
+    struct FEntry
+    {
+        EActionType ActionType = EActionType::Idle;
+        FVector Location = FVector::ZeroVector;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        bool bFree = false;
+    };
+
+    struct FActionGrid
+    {
+        TMap<FIntPoint, TArray<AInteractableObject*>> Cells;
+        FIntPoint MinCell = FIntPoint(MAX_int32, MAX_int32);
+        FIntPoint MaxCell = FIntPoint(MIN_int32, MIN_int32);
+        int32 NumFree = 0;
+    };
+
+    FIntPoint ToCell(const FVector& Location) const;
+    void Link(AInteractableObject* Object, FEntry& Entry);
+    void Unlink(AInteractableObject* Object, FEntry& Entry);
+
+    float CellSize;
+    TMap<const AInteractableObject*, FEntry> Entries;
+    FActionGrid Grids[(int32)EActionType::MAX];
+};
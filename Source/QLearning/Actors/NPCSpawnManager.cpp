@@ -3,6 +3,9 @@
 #include "../Utils/GenerationLogger.h"
 #include "Engine/TargetPoint.h"
 #include "Kismet/GameplayStatics.h"
+#include "../Subsystems/TravelCostSubsystem.h"
+#include "../Subsystems/NPCDecisionSubsystem.h"
+#include "../Subsystems/QTableCacheSubsystem.h"
 
 ANPCSpawnManager::ANPCSpawnManager()
 {
@@ -35,9 +38,36 @@ void ANPCSpawnManager::BeginPlay()
         UE_LOG(LogTemp, Warning, TEXT("Found %d spawn points"), SpawnPoints.Num());
     }
 
-    if (bAutoStart)
+    if (UTravelCostSubsystem* TravelCost = GetWorld()->GetSubsystem<UTravelCostSubsystem>())
     {
-        StartSimulation();
+        for (ATargetPoint* SpawnPoint : SpawnPoints)
+        {
+            TravelCost->RegisterNode(SpawnPoint);
+        }
+    }
+
+    if (UNPCDecisionSubsystem* DecisionSubsystem = GetWorld()->GetSubsystem<UNPCDecisionSubsystem>())
+    {
+        DecisionSubsystem->SetFrameBudgetMs(DecisionBudgetMs);
+        DecisionSubsystem->SetInferenceBatchSize(InferenceBatchSize);
+    }
+
+    UHighLevelLearningSubsystem* Learning = GetWorld()->GetSubsystem<UHighLevelLearningSubsystem>();
+    if (Learning && !bLearningConfigured)
+    {
+        ConfigureLearning(*Learning);
+    }
+
+    // Кукнута таблиця може ще вантажитися: пул і спавн стартують, коли вона готова, а не блокують BeginPlay.
+    // Замороженій політиці таблиця не потрібна - не чекаємо
+    UQTableCacheSubsystem* TableCache = GetWorld()->GetSubsystem<UQTableCacheSubsystem>();
+    if (TableCache && !UsesFrozenPolicy())
+    {
+        TableCache->WhenReady(TEXT("HighLevelQTable.json"), FSimpleDelegate::CreateUObject(this, &ANPCSpawnManager::HandleTableReady));
+    }
+    else
+    {
+        HandleTableReady();
     }
 
     /* IDK if I gonna use it or not
@@ -49,6 +79,41 @@ void ANPCSpawnManager::BeginPlay()
      */
 }
 
+bool ANPCSpawnManager::UsesFrozenPolicy() const
+{
+    const ANPCCharacter* NPCDefaults = NPCClass ? NPCClass->GetDefaultObject<ANPCCharacter>() : nullptr;
+    return NPCDefaults && NPCDefaults->bUseFrozenPolicy && ANPCCharacter::HasCompiledPolicy();
+}
+
+void ANPCSpawnManager::HandleTableReady()
+{
+    // Таблицю розбираємо один раз до першого NPC, далі вони беруть її з кешу
+    UQTableCacheSubsystem* TableCache = GetWorld() ? GetWorld()->GetSubsystem<UQTableCacheSubsystem>() : nullptr;
+    if (TableCache && !UsesFrozenPolicy())
+    {
+        TableCache->FindOrLoad(TEXT("HighLevelQTable.json"));
+    }
+
+    if (bUseNPCPool)
+    {
+        PrewarmPool();
+    }
+
+    if (bAutoStart)
+    {
+        StartSimulation();
+    }
+}
+
+void ANPCSpawnManager::ConfigureLearning(UHighLevelLearningSubsystem& Learning)
+{
+    Learning.SetSharedTableEnabled(bShareQTable);
+    Learning.ConfigureReplay(ReplayConfig);
+    Learning.ConfigurePlanning(PlanningConfig);
+    Learning.ConfigureAsyncLearner(AsyncLearnerConfig);
+    bLearningConfigured = true;
+}
+
 void ANPCSpawnManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -56,6 +121,7 @@ void ANPCSpawnManager::Tick(float DeltaTime)
     if (bIsRunning)
     {
         //CheckAndRespawnNPCs();
+        ProcessSpawnQueue();
     }
 }
 
@@ -74,7 +140,69 @@ void ANPCSpawnManager::StartSimulation()
 
     for (int32 i = 0; i < TargetNPCCount; i++)
     {
-        SpawnNPC(i);
+        QueueSpawn(i);
+    }
+}
+
+void ANPCSpawnManager::QueueSpawn(int32 NPCID)
+{
+    PendingSpawns.Add(NPCID);
+    NumSpawnsQueued++;
+}
+
+float ANPCSpawnManager::GetSpawnProgress() const
+{
+    return NumSpawnsQueued > 0 ? (float)NumSpawnsDone / NumSpawnsQueued : 1.0f;
+}
+
+void ANPCSpawnManager::ProcessSpawnQueue()
+{
+    if (NumPendingSpawns() == 0)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = SpawnBudgetMs / 1000.0;
+    int32 NumSpawnedThisFrame = 0;
+
+    // FIFO, щоб NPC з'являлись у порядку ID; голова зсувається без перенесення масиву
+    do
+    {
+        const int32 NPCID = PendingSpawns[PendingSpawnHead++];
+        
+        SpawnNPC(NPCID);
+        NumSpawnsDone++;
+        NumSpawnedThisFrame++;
+    }
+    while (NumPendingSpawns() > 0 && FPlatformTime::Seconds() - StartTime < BudgetSeconds);
+
+    // Респавни можуть підтримувати чергу непорожньою довго - з'їдену голову зрідка відрізаємо
+    if (PendingSpawnHead > 32 && PendingSpawnHead * 2 > PendingSpawns.Num())
+    {
+        PendingSpawns.RemoveAt(0, PendingSpawnHead, EAllowShrinking::No);
+        PendingSpawnHead = 0;
+    }
+
+    OnSpawnProgress.Broadcast(NumSpawnsDone, NumSpawnsQueued);
+
+    if (NumPendingSpawns() == 0)
+    {
+        PendingSpawns.Reset();
+        PendingSpawnHead = 0;
+        
+        if (NumSpawnsQueued > 1)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Spawn wave finished: %d NPCs"), NumSpawnsQueued);
+        }
+        NumSpawnsQueued = 0;
+        NumSpawnsDone = 0;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("Spawn progress: %d/%d (%d this frame, %.2f ms)"), 
+               NumSpawnsDone, NumSpawnsQueued, NumSpawnedThisFrame, 
+               (FPlatformTime::Seconds() - StartTime) * 1000.0);
     }
 }
 
@@ -83,16 +211,36 @@ void ANPCSpawnManager::StopSimulation()
     bIsRunning = false;
     UE_LOG(LogTemp, Warning, TEXT("=== SIMULATION STOPPED ==="));
     
+    PendingSpawns.Reset();
+    PendingSpawnHead = 0;
+    NumSpawnsQueued = 0;
+    NumSpawnsDone = 0;
+    
     for (ANPCCharacter* NPC : ActiveNPCs)
     {
-        if (IsValid(NPC))  
+        if (!IsValid(NPC))  
+        {
+            continue;
+        }
+        
+        if (NPC->bReturnToPoolOnDeath)
+        {
+            ReleaseToPool(NPC);
+        }
+        else
         {
             NPC->Destroy();
         }
     }
     ActiveNPCs.Empty();
+    ActiveSlotByID.Empty();
     
     UGenerationLogger::LogSummary();
+    
+    if (UNPCDecisionSubsystem* DecisionSubsystem = GetWorld()->GetSubsystem<UNPCDecisionSubsystem>())
+    {
+        DecisionSubsystem->LogLatencyStats();
+    }
 }
 
 void ANPCSpawnManager::ResetSimulation()
@@ -124,17 +272,32 @@ void ANPCSpawnManager::SpawnNPC(int32 NPCID)
         return;
     }
 
-    FVector SpawnLocation = GetSpawnLocation(NPCID);
+    AActor* SpawnPoint = nullptr;
+    FVector SpawnLocation = GetSpawnLocation(NPCID, &SpawnPoint);
     FRotator SpawnRotation = FRotator::ZeroRotator;
     
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-    ANPCCharacter* NewNPC = GetWorld()->SpawnActor<ANPCCharacter>(NPCClass, SpawnLocation, SpawnRotation, SpawnParams);
+    const FTransform SpawnTransform(SpawnRotation, SpawnLocation);
+    
+    ANPCCharacter* NewNPC = nullptr;
+    const bool bFromPool = bUseNPCPool && DormantNPCs.Num() > 0;
+    
+    if (bFromPool)
+    {
+        NewNPC = DormantNPCs.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        // Відкладений спавн: покоління виставляється до BeginPlay, тож NeedsComponent
+        // одразу стартує з правильними значеннями
+        NewNPC = GetWorld()->SpawnActorDeferred<ANPCCharacter>(NPCClass, SpawnTransform, this, nullptr,
+                                                               ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+    }
 
     if (NewNPC)
     {
         NewNPC->NPCID = NPCID;
+        NewNPC->SetTravelNode(SpawnPoint);
+        NewNPC->bReturnToPoolOnDeath = bUseNPCPool;
         
         if (!NPCGenerations.Contains(NPCID))
         {
@@ -152,41 +315,78 @@ void ANPCSpawnManager::SpawnNPC(int32 NPCID)
         if (NewNPC->NeedsComponent)
         {
             NewNPC->NeedsComponent->CurrentGeneration = NewNPC->Generation;
-            CurrentDyingNPC = NewNPC;
-            NewNPC->NeedsComponent->OnNPCDied.AddDynamic(this, &ANPCSpawnManager::HandleNPCDeath);
         }
+        NewNPC->OnDied.AddUniqueDynamic(this, &ANPCSpawnManager::OnNPCDied);
 
-        if (bShareQTable && NewNPC->HighLevelQL)
+        if (bFromPool)
         {
-            NewNPC->HighLevelQL->LoadQTable("HighLevelQTable.json");
+            // Скидає потреби для нового покоління і перезавантажує таблицю
+            NewNPC->ActivateFromPool(SpawnLocation, SpawnRotation);
+        }
+        else
+        {
+            // BeginPlay завантажує спільну таблицю з кешу
+            NewNPC->FinishSpawning(SpawnTransform);
         }
 
-        ActiveNPCs.Add(NewNPC);
+        AddActiveNPC(NewNPC);
 
         UE_LOG(LogTemp, Warning, TEXT("Spawned NPC %d (Generation %d) at %s"), 
                NPCID, NewNPC->Generation, *SpawnLocation.ToString());
     }
 }
 
-void ANPCSpawnManager::HandleNPCDeath()
+void ANPCSpawnManager::AddActiveNPC(ANPCCharacter* NPC)
 {
-    ANPCCharacter* DeadNPC = nullptr;
-    
-    for (ANPCCharacter* NPC : ActiveNPCs)
+    if (NPC->NPCID >= ActiveSlotByID.Num())
     {
-        if (IsValid(NPC) && NPC->NeedsComponent && !NPC->NeedsComponent->bIsAlive)
+        const int32 OldNum = ActiveSlotByID.Num();
+        ActiveSlotByID.SetNumUninitialized(NPC->NPCID + 1);
+        for (int32 i = OldNum; i < ActiveSlotByID.Num(); i++)
         {
-            DeadNPC = NPC;
-            break;
+            ActiveSlotByID[i] = INDEX_NONE;
         }
     }
+    
+    ActiveSlotByID[NPC->NPCID] = ActiveNPCs.Add(NPC);
+}
 
-    if (DeadNPC)
+void ANPCSpawnManager::RemoveActiveNPC(ANPCCharacter* NPC)
+{
+    int32 Slot = ActiveSlotByID.IsValidIndex(NPC->NPCID) ? ActiveSlotByID[NPC->NPCID] : INDEX_NONE;
+    
+    // Два NPC з одним ID (ручний SpawnNPC) - рідкісний випадок, шукаємо лінійно
+    if (!ActiveNPCs.IsValidIndex(Slot) || ActiveNPCs[Slot] != NPC)
     {
-        OnNPCDied(DeadNPC);
+        Slot = ActiveNPCs.Find(NPC);
+        if (Slot == INDEX_NONE)
+        {
+            return;
+        }
+    }
+    else
+    {
+        ActiveSlotByID[NPC->NPCID] = INDEX_NONE;
+    }
+    
+    ActiveNPCs.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    
+    if (ActiveNPCs.IsValidIndex(Slot))
+    {
+        const int32 MovedID = ActiveNPCs[Slot]->NPCID;
+        if (ActiveSlotByID.IsValidIndex(MovedID) && ActiveSlotByID[MovedID] == ActiveNPCs.Num())
+        {
+            ActiveSlotByID[MovedID] = Slot;
+        }
     }
 }
 
+ANPCCharacter* ANPCSpawnManager::GetActiveNPC(int32 NPCID) const
+{
+    const int32 Slot = ActiveSlotByID.IsValidIndex(NPCID) ? ActiveSlotByID[NPCID] : INDEX_NONE;
+    return ActiveNPCs.IsValidIndex(Slot) ? ActiveNPCs[Slot] : nullptr;
+}
+
 void ANPCSpawnManager::OnNPCDied(ANPCCharacter* DeadNPC)
 {
     if (!DeadNPC)
@@ -197,7 +397,22 @@ void ANPCSpawnManager::OnNPCDied(ANPCCharacter* DeadNPC)
     UE_LOG(LogTemp, Error, TEXT("Manager: NPC %d died (Generation %d)"), 
            DeadNPC->NPCID, DeadNPC->Generation);
     
-    ActiveNPCs.Remove(DeadNPC);
+    RemoveActiveNPC(DeadNPC);
+    
+    if (DeadNPC->bReturnToPoolOnDeath)
+    {
+        // Тіло йде в пул раніше за респавн цього ж ID, тож SpawnNPC перевикористає саме його
+        const float PoolDelay = FMath::Min(CorpseLifetime, RespawnDelay * 0.5f);
+        TWeakObjectPtr<ANPCCharacter> WeakNPC = DeadNPC;
+        FTimerHandle CorpseTimer;
+        GetWorld()->GetTimerManager().SetTimer(CorpseTimer, [this, WeakNPC]()
+        {
+            if (WeakNPC.IsValid())
+            {
+                ReleaseToPool(WeakNPC.Get());
+            }
+        }, FMath::Max(PoolDelay, 0.01f), false);
+    }
     
     int32 NPCID = DeadNPC->NPCID;
     
@@ -206,41 +421,83 @@ void ANPCSpawnManager::OnNPCDied(ANPCCharacter* DeadNPC)
     {
         if (bIsRunning)
         {
-            SpawnNPC(NPCID);
+            QueueSpawn(NPCID);
         }
     }, RespawnDelay, false);
 }
 
 void ANPCSpawnManager::CheckAndRespawnNPCs()
 {
-    ActiveNPCs.RemoveAll([](ANPCCharacter* NPC) 
-    { 
-        return !IsValid(NPC); 
-    });
+    for (int32 i = ActiveNPCs.Num() - 1; i >= 0; i--)
+    {
+        if (!IsValid(ActiveNPCs[i]))
+        {
+            ActiveNPCs.RemoveAtSwap(i, 1, EAllowShrinking::No);
+        }
+    }
     
-    if (ActiveNPCs.Num() < TargetNPCCount)
+    // Після видалення невалідних індекси перебудовуються повністю
+    ActiveSlotByID.Init(INDEX_NONE, ActiveSlotByID.Num());
+    for (int32 Slot = 0; Slot < ActiveNPCs.Num(); Slot++)
     {
-        TArray<int32> ActiveIDs;
-        for (ANPCCharacter* NPC : ActiveNPCs)
+        if (ActiveSlotByID.IsValidIndex(ActiveNPCs[Slot]->NPCID))
         {
-            if (IsValid(NPC))  
-            {
-                ActiveIDs.Add(NPC->NPCID);
-            }
+            ActiveSlotByID[ActiveNPCs[Slot]->NPCID] = Slot;
         }
-        
+    }
+    
+    if (ActiveNPCs.Num() + NumPendingSpawns() < TargetNPCCount)
+    {
+        const TArrayView<const int32> Pending = MakeArrayView(PendingSpawns).RightChop(PendingSpawnHead);
         for (int32 i = 0; i < TargetNPCCount; i++)
         {
-            if (!ActiveIDs.Contains(i))
+            if (!GetActiveNPC(i) && !Pending.Contains(i))
             {
-                SpawnNPC(i);
+                QueueSpawn(i);
                 break;
             }
         }
     }
 }
 
-FVector ANPCSpawnManager::GetSpawnLocation(int32 NPCID)
+void ANPCSpawnManager::PrewarmPool()
+{
+    if (!NPCClass)
+    {
+        return;
+    }
+
+    const int32 NumToSpawn = (PoolSize > 0 ? PoolSize : TargetNPCCount) - DormantNPCs.Num();
+    
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    
+    for (int32 i = 0; i < NumToSpawn; i++)
+    {
+        ANPCCharacter* NPC = GetWorld()->SpawnActor<ANPCCharacter>(NPCClass, GetActorLocation(), 
+                                                                   FRotator::ZeroRotator, SpawnParams);
+        if (NPC)
+        {
+            NPC->bReturnToPoolOnDeath = true;
+            ReleaseToPool(NPC);
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("NPC pool prewarmed: %d dormant NPCs"), DormantNPCs.Num());
+}
+
+void ANPCSpawnManager::ReleaseToPool(ANPCCharacter* NPC)
+{
+    if (!IsValid(NPC) || NPC->IsDormant())
+    {
+        return;
+    }
+
+    NPC->DeactivateToPool();
+    DormantNPCs.Add(NPC);
+}
+
+FVector ANPCSpawnManager::GetSpawnLocation(int32 NPCID, AActor** OutSpawnPoint)
 {
     if (SpawnPoints.Num() > 0)
     {
@@ -251,6 +508,10 @@ FVector ANPCSpawnManager::GetSpawnLocation(int32 NPCID)
             FVector Location = SpawnPoints[RandomIndex]->GetActorLocation();
             UE_LOG(LogTemp, Log, TEXT("Spawn location from TargetPoint %d: %s"), 
                    RandomIndex, *Location.ToString());
+            if (OutSpawnPoint)
+            {
+                *OutSpawnPoint = SpawnPoints[RandomIndex];
+            }
             return Location;
         }
     }
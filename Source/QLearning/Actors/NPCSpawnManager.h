@@ -3,9 +3,10 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "../Characters/NPCCharacter.h"
+#include "../Subsystems/HighLevelLearningSubsystem.h"
 #include "NPCSpawnManager.generated.h"
 
-
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSpawnProgressSignature, int32, NumSpawned, int32, NumQueued);
 
 UCLASS()
 class QLEARNING_API ANPCSpawnManager : public AActor
@@ -36,18 +37,72 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Settings")
     bool bAutoStart = true;  
 
+    // Мертві NPC повертаються в пул і перевикористовуються замість SpawnActor/Destroy
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    bool bUseNPCPool = true;
+
+    // Скільки сплячих NPC створити заздалегідь (0 - TargetNPCCount)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    int32 PoolSize = 0;
+
+    // Скільки секунд тіло лишається на сцені перед поверненням у пул.
+    // Має бути меншим за RespawnDelay, інакше респавн не застане тіло в пулі і створить зайвого NPC
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    float CorpseLifetime = 1.0f;
+
+    // Скільки мілісекунд за кадр можна витратити на спавн черги NPC (мінімум один NPC за кадр)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    float SpawnBudgetMs = 2.0f;
+
+    // Скільки мілісекунд за кадр можна витратити на рішення NPC
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    float DecisionBudgetMs = 0.5f;
+
+    // NPC, що вирішують в одному кадрі, оцінюються одним пакетом спільної DQN-мережі (1 - без пакетів)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    int32 InferenceBatchSize = 1;
+
+    // Усі живі NPC вчаться в одній таблиці UHighLevelLearningSubsystem (інакше - власні копії з файлу)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
     bool bShareQTable = true; 
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+    FHighLevelReplayConfig ReplayConfig;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+    FHighLevelPlanningConfig PlanningConfig;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+    FHighLevelAsyncLearnerConfig AsyncLearnerConfig;
     
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     int32 TotalGenerations = 0;
 
+    // Щільний масив живих NPC; порядок не зберігається (видалення через swap)
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
     TArray<ANPCCharacter*> ActiveNPCs;
     
+    UFUNCTION(BlueprintPure, Category = "Stats")
+    ANPCCharacter* GetActiveNPC(int32 NPCID) const;
+    
+    UPROPERTY(BlueprintAssignable, Category = "Spawn")
+    FOnSpawnProgressSignature OnSpawnProgress;
+    
     UFUNCTION(BlueprintCallable, Category = "Spawn")
     void SpawnNPC(int32 NPCID);
 
+    // Спільна таблиця, повтори, планування, учень. Для менеджера з рівня викликає
+    // UHighLevelLearningSubsystem::OnWorldBeginPlay, для заспавненого пізніше - BeginPlay
+    void ConfigureLearning(UHighLevelLearningSubsystem& Learning);
+
+    // Спавн у наступних кадрах у межах SpawnBudgetMs
+    UFUNCTION(BlueprintCallable, Category = "Spawn")
+    void QueueSpawn(int32 NPCID);
+
+    // 0..1 для поточної хвилі спавну, 1 якщо черга порожня
+    UFUNCTION(BlueprintPure, Category = "Spawn")
+    float GetSpawnProgress() const;
+
     UFUNCTION(BlueprintCallable, Category = "Spawn")
     void StartSimulation();
 
@@ -61,17 +116,32 @@ protected:
     UFUNCTION()
     void OnNPCDied(ANPCCharacter* DeadNPC);
 
+    void AddActiveNPC(ANPCCharacter* NPC);
+    void RemoveActiveNPC(ANPCCharacter* NPC);
     void CheckAndRespawnNPCs();
-    FVector GetSpawnLocation(int32 NPCID);
-
-protected:
-    UFUNCTION()
-    void HandleNPCDeath();  
+    void ProcessSpawnQueue();
+    void PrewarmPool();
+    void ReleaseToPool(ANPCCharacter* NPC);
+    void HandleTableReady();
+    bool UsesFrozenPolicy() const;
+    FVector GetSpawnLocation(int32 NPCID, AActor** OutSpawnPoint = nullptr);
 
 private:
-    ANPCCharacter* CurrentDyingNPC = nullptr; 
+    UPROPERTY()
+    TArray<ANPCCharacter*> DormantNPCs;
+
+    // NPCID -> індекс в ActiveNPCs або INDEX_NONE
+    TArray<int32> ActiveSlotByID;
+    
+    // Черга ID на спавн: голова рухається індексом, масив скидається, коли хвиля завершується
+    TArray<int32> PendingSpawns;
+    int32 PendingSpawnHead = 0;
+    int32 NumPendingSpawns() const { return PendingSpawns.Num() - PendingSpawnHead; }
+    int32 NumSpawnsQueued = 0;
+    int32 NumSpawnsDone = 0;
     
     bool bIsRunning = false;
+    bool bLearningConfigured = false;
     TMap<int32, int32> NPCGenerations; 
     FTimerHandle RespawnCheckTimer;
 };
\ No newline at end of file
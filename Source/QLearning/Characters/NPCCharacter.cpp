@@ -1,8 +1,11 @@
 #include "Characters/NPCCharacter.h"
-#include "Kismet/GameplayStatics.h"
 #include "../Utils/CSVLogger.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Utils/GenerationLogger.h"
+#include "Subsystems/InteractableRegistrySubsystem.h"
+#include "Subsystems/TravelCostSubsystem.h"
+#include "Subsystems/NPCDecisionSubsystem.h"
+#include "Core/CompiledHighLevelPolicy.h"
 
 ANPCCharacter::ANPCCharacter()
 {
@@ -17,9 +20,18 @@ void ANPCCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
+    if (bUseFrozenPolicy && !HasCompiledPolicy())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: no compiled policy, falling back to learning"), *GetName());
+        bUseFrozenPolicy = false;
+    }
+    
     // Створюємо High-Level Q-Learning
-    HighLevelQL = NewObject<UHighLevelQLearning>(this, UHighLevelQLearning::StaticClass());
-    HighLevelQL->RegisterComponent();
+    if (!bUseFrozenPolicy)
+    {
+        HighLevelQL = NewObject<UHighLevelQLearning>(this, UHighLevelQLearning::StaticClass());
+        HighLevelQL->RegisterComponent();
+    }
     
     AIController = Cast<AAIController>(GetController());
     if (!AIController)
@@ -46,15 +58,20 @@ void ANPCCharacter::BeginPlay()
     if (NeedsComponent)
     {
         NeedsComponent->OnNPCDied.AddDynamic(this, &ANPCCharacter::OnNPCDied);
+        NeedsComponent->OnNeedLevelChanged.AddUObject(this, &ANPCCharacter::OnNeedLevelChanged);
     }
 
-    FindAvailableObjects();
+    InteractableRegistry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>();
+    TravelCost = GetWorld()->GetSubsystem<UTravelCostSubsystem>();
+    
+    DecisionSubsystem = GetWorld()->GetSubsystem<UNPCDecisionSubsystem>();
     
     bExecutingMacroAction = false;
 
-    GetWorld()->GetTimerManager().SetTimer(DecisionTimerHandle, this, 
-        &ANPCCharacter::MakeDecision,
-        DecisionInterval, true);
+    if (DecisionSubsystem)
+    {
+        DecisionSubsystem->RequestDecision(this);
+    }
 }
 
 void ANPCCharacter::Tick(float DeltaTime)
@@ -65,53 +82,255 @@ void ANPCCharacter::Tick(float DeltaTime)
     {
         Lifetime += DeltaTime;
     }
+    
+    // Оцінка черги могла бути хибною - не стоїмо біля об'єкта, доки не вб'ють потреби
+    if (CurrentState == ENPCState::WaitingInQueue && GetWorld()->GetTimeSeconds() - QueueWaitStartTime > MaxQueueWaitTime)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: gave up waiting in queue for %s"), *GetName(), 
+               CurrentTarget ? *CurrentTarget->GetName() : TEXT("None"));
+        OnMacroActionCompleted(false);
+    }
+}
+
+AInteractableObject* ANPCCharacter::FindBestFreeObject(EActionType Action, float& OutTravelTime) const
+{
+    const float Speed = GetCharacterMovement()->MaxWalkSpeed;
+    
+    // Стоїмо на відомому вузлі - беремо довжини шляхів з кешу навмешу
+    if (TravelCost && CurrentTravelNode.IsValid())
+    {
+        float PathLength = 0.0f;
+        if (AInteractableObject* Object = TravelCost->FindBestFreeObject(Action, CurrentTravelNode.Get(), &PathLength))
+        {
+            OutTravelTime = PathLength / FMath::Max(Speed, 1.0f);
+            return Object;
+        }
+    }
+    
+    float DistSquared = 0.0f;
+    AInteractableObject* Object = InteractableRegistry ? 
+        InteractableRegistry->FindNearestFree(Action, GetActorLocation(), &DistSquared) : nullptr;
+    OutTravelTime = Object ? FMath::Sqrt(DistSquared) / FMath::Max(Speed, 1.0f) : 0.0f;
+    return Object;
+}
+
+AInteractableObject* ANPCCharacter::FindShortestQueueObject(EActionType Action, float& OutTravelTime, 
+                                                            float& OutWaitTime) const
+{
+    if (!InteractableRegistry)
+    {
+        return nullptr;
+    }
+    
+    const float Speed = FMath::Max(GetCharacterMovement()->MaxWalkSpeed, 1.0f);
+    const int32 FromNode = TravelCost && CurrentTravelNode.IsValid() ? 
+        TravelCost->GetNodeIndex(CurrentTravelNode.Get()) : INDEX_NONE;
+    
+    AInteractableObject* Best = nullptr;
+    float BestTime = TNumericLimits<float>::Max();
+    
+    // Тільки коли вільних немає; проходимо лише об'єкти потрібного типу
+    for (AInteractableObject* Object : InteractableRegistry->GetInteractables(Action))
+    {
+        if (!IsValid(Object))
+        {
+            continue;
+        }
+        
+        const float WaitTime = Object->EstimateWaitTime();
+        if (WaitTime > MaxQueueWaitTime)
+        {
+            continue;
+        }
+        
+        const int32 ToNode = FromNode != INDEX_NONE ? TravelCost->GetNodeIndex(Object) : INDEX_NONE;
+        const float TravelTime = ToNode != INDEX_NONE ? 
+            TravelCost->GetTravelTime(FromNode, ToNode, Speed) : 
+            FVector::Dist(GetActorLocation(), Object->GetActorLocation()) / Speed;
+        
+        // Черга рухається, поки NPC іде
+        const float TotalTime = FMath::Max(TravelTime, WaitTime);
+        if (TotalTime < BestTime)
+        {
+            BestTime = TotalTime;
+            Best = Object;
+            OutTravelTime = TravelTime;
+            OutWaitTime = WaitTime;
+        }
+    }
+    
+    return Best;
+}
+
+void ANPCCharacter::OnReservationGranted(AInteractableObject* Object)
+{
+    if (Object != CurrentTarget)
+    {
+        return;
+    }
+    
+    bQueuedForTarget = false;
+    
+    // Вже стоїмо біля об'єкта - починаємо одразу
+    if (CurrentState == ENPCState::WaitingInQueue)
+    {
+        StartInteractionWithObject();
+    }
 }
 
-void ANPCCharacter::FindAvailableObjects()
+void ANPCCharacter::OnReservationFailed(AInteractableObject* Object)
 {
-    AvailableObjects.Empty();
+    if (Object != CurrentTarget || !bExecutingMacroAction)
+    {
+        return;
+    }
     
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AInteractableObject::StaticClass(), FoundActors);
+    // Об'єкт сам прибрав нас із черги; якщо ще йдемо - зупиняємось без OnMoveCompleted
+    CurrentTarget = nullptr;
+    bQueuedForTarget = false;
     
-    for (AActor* Actor : FoundActors)
+    if (AIController)
     {
-        AInteractableObject* Object = Cast<AInteractableObject>(Actor);
-        if (Object)
+        if (AIController->GetPathFollowingComponent())
         {
-            AvailableObjects.Add(Object);
+            AIController->GetPathFollowingComponent()->OnRequestFinished.Clear();
         }
+        AIController->StopMovement();
     }
+    
+    OnMacroActionCompleted(false);
+}
 
-    UE_LOG(LogTemp, Log, TEXT("Found %d interactable objects"), AvailableObjects.Num());
+void ANPCCharacter::ReleaseTarget()
+{
+    if (CurrentTarget)
+    {
+        CurrentTarget->ReleaseReservation(this);
+        CurrentTarget = nullptr;
+    }
+    bQueuedForTarget = false;
 }
 
-TArray<AActor*> ANPCCharacter::GetInteractableObjectsForAction(EActionType Action)
+void ANPCCharacter::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
 {
-    TArray<AActor*> Result;
+    SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+    SetActorTickEnabled(true);
+    GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+    
+    Lifetime = 0.0f;
+    TotalActionsPerformed = 0;
+    CauseOfDeath = ENeedType::Hunger;
+    CurrentState = ENPCState::Idle;
+    CurrentTarget = nullptr;
+    bExecutingMacroAction = false;
+    BlockedActionType = EActionType::MAX;
+    bQueuedForTarget = false;
+    ConsecutiveFailures = 0;
+    bIsDormant = false;
+    
+    if (NeedsComponent)
+    {
+        NeedsComponent->ResetNeeds();
+        NeedsComponent->SetComponentTickEnabled(true);
+    }
     
-    for (AInteractableObject* Object : AvailableObjects)
+    if (HighLevelQL)
     {
-        if (Object && Object->ActionType == Action && Object->CanInteract())
+        HighLevelQL->ResetLearner();
+    }
+    
+    if (DecisionSubsystem)
+    {
+        DecisionSubsystem->RequestDecision(this);
+    }
+}
+
+void ANPCCharacter::DeactivateToPool()
+{
+    bIsDormant = true;
+    
+    if (DecisionSubsystem)
+    {
+        DecisionSubsystem->CancelDecision(this);
+    }
+    
+    if (AIController)
+    {
+        AIController->StopMovement();
+        if (AIController->GetPathFollowingComponent())
         {
-            Result.Add(Object);
+            AIController->GetPathFollowingComponent()->OnRequestFinished.Clear();
         }
     }
     
-    // Сортуємо за відстанню
-    Result.Sort([this](const AActor& A, const AActor& B)
+    if (CurrentTarget)
+    {
+        CurrentTarget->CancelInteraction(this);
+        CurrentTarget = nullptr;
+    }
+    bQueuedForTarget = false;
+    
+    if (NeedsComponent)
+    {
+        NeedsComponent->SetComponentTickEnabled(false);
+    }
+    
+    GetCharacterMovement()->StopMovementImmediately();
+    GetCharacterMovement()->DisableMovement();
+    SetActorTickEnabled(false);
+    SetActorEnableCollision(false);
+    SetActorHiddenInGame(true);
+    
+    bExecutingMacroAction = false;
+    CurrentState = ENPCState::Idle;
+    CurrentTravelNode = nullptr;
+}
+
+void ANPCCharacter::OnNeedLevelChanged(ENeedType NeedType, ENeedLevel NewLevel)
+{
+    // Стан змінився, поки NPC чекав на вільний об'єкт - переглядаємо рішення
+    if (!bExecutingMacroAction && DecisionSubsystem && DecisionSubsystem->IsWaiting(this))
+    {
+        DecisionSubsystem->RequestDecision(this);
+    }
+}
+
+bool ANPCCharacter::HasCompiledPolicy()
+{
+    return CompiledHighLevelPolicy::NumStates == FHighLevelQTable::NumStates &&
+           CompiledHighLevelPolicy::NumActions == FHighLevelQTable::NumActions;
+}
+
+EMacroAction ANPCCharacter::ChooseFrozenMacroAction()
+{
+    float NeedValues[FHighLevelQTable::NumNeeds];
+    NeedsComponent->GetNeedValues(NeedValues);
+    FrozenStateIndex = FHighLevelQTable::PackNeedValues(NeedValues);
+    
+    const int32 GreedyAction = CompiledHighLevelPolicy::GreedyAction[FrozenStateIndex];
+    if (!InteractableRegistry || 
+        InteractableRegistry->NumFree(UHighLevelQLearning::GetActionTypeForMacroAction((EMacroAction)GreedyAction)) > 0)
     {
-        float DistA = FVector::Dist(GetActorLocation(), A.GetActorLocation());
-        float DistB = FVector::Dist(GetActorLocation(), B.GetActorLocation());
-        return DistA < DistB;
-    });
+        return (EMacroAction)GreedyAction;
+    }
     
-    return Result;
+    // Для жадібної дії все зайнято - наступна за Q, де є вільний об'єкт
+    for (int32 Rank = 0; Rank < CompiledHighLevelPolicy::NumFallbacks; Rank++)
+    {
+        const int32 Action = CompiledHighLevelPolicy::FallbackOrder[FrozenStateIndex * CompiledHighLevelPolicy::NumFallbacks + Rank];
+        if (InteractableRegistry->NumFree(UHighLevelQLearning::GetActionTypeForMacroAction((EMacroAction)Action)) > 0)
+        {
+            return (EMacroAction)Action;
+        }
+    }
+    return (EMacroAction)GreedyAction;
 }
 
 void ANPCCharacter::MakeDecision()
 {
-    if (!NeedsComponent || !NeedsComponent->bIsAlive || !HighLevelQL)
+    if (!NeedsComponent || !NeedsComponent->bIsAlive || (!HighLevelQL && !bUseFrozenPolicy))
     {
         return;
     }
@@ -141,12 +360,27 @@ void ANPCCharacter::MakeDecision()
     {
         UE_LOG(LogTemp, Error, TEXT("🚨 %s EMERGENCY: Need %d = %.1f"), 
                *GetName(), (int32)CriticalNeed, LowestValue);
+        
+        // CSV-лог замороженої політики пише стан і для екстрених дій
+        if (bUseFrozenPolicy)
+        {
+            float NeedValues[FHighLevelQTable::NumNeeds];
+            NeedsComponent->GetNeedValues(NeedValues);
+            FrozenStateIndex = FHighLevelQTable::PackNeedValues(NeedValues);
+        }
         ExecuteMacroAction((EMacroAction)((int32)CriticalNeed));
         return;
     }
     
+    if (bUseFrozenPolicy)
+    {
+        CurrentMacroAction = ChooseFrozenMacroAction();
+        ExecuteMacroAction(CurrentMacroAction);
+        return;
+    }
+    
     // High-Level Q-Learning вибирає дію
-    StateBeforeMacroAction = HighLevelQL->GetCurrentState();
+    StateBeforeMacroAction = HighLevelQL->GetDecisionState();
     CurrentMacroAction = HighLevelQL->ChooseMacroAction(StateBeforeMacroAction);
     
     UE_LOG(LogTemp, Log, TEXT("%s chose macro-action: %d"), 
@@ -160,37 +394,43 @@ void ANPCCharacter::ExecuteMacroAction(EMacroAction MacroAction)
     bExecutingMacroAction = true;
     MacroActionStartTime = GetWorld()->GetTimeSeconds();
     
-    ENeedType TargetNeed = (ENeedType)((int32)MacroAction);
+    EActionType ActionType = UHighLevelQLearning::GetActionTypeForMacroAction(MacroAction);
     
-    EActionType ActionType = EActionType::Idle;
-    switch (TargetNeed)
+    CurrentTarget = FindBestFreeObject(ActionType, ExpectedTravelTime);
+    
+    if (CurrentTarget)
     {
-        case ENeedType::Hunger:   ActionType = EActionType::UseRefrigerator; break;
-        case ENeedType::Bladder:  ActionType = EActionType::UseToilet; break;
-        case ENeedType::Energy:   ActionType = EActionType::UseBed; break;
-        case ENeedType::Social:   ActionType = EActionType::UseSofa; break;
-        case ENeedType::Hygiene:  ActionType = EActionType::UseShower; break;
-        case ENeedType::Fun:      ActionType = EActionType::UseTelevision; break;
+        // Займаємо об'єкт одразу, щоб ніхто не пішов до нього паралельно
+        CurrentTarget->Reserve(this, ExpectedTravelTime + ReservationSlack);
+    }
+    else
+    {
+        float WaitTime = 0.0f;
+        CurrentTarget = FindShortestQueueObject(ActionType, ExpectedTravelTime, WaitTime);
+        if (CurrentTarget)
+        {
+            bQueuedForTarget = !CurrentTarget->Reserve(this, ExpectedTravelTime + ReservationSlack, 
+                FOnReservationGranted::CreateUObject(this, &ANPCCharacter::OnReservationGranted),
+                FOnReservationFailed::CreateUObject(this, &ANPCCharacter::OnReservationFailed));
+            
+            UE_LOG(LogTemp, Log, TEXT("%s: queued for %s, estimated wait %.1fs"), 
+                   *GetName(), *CurrentTarget->GetName(), WaitTime);
+        }
     }
     
-    TArray<AActor*> AvailableObjectsForAction = GetInteractableObjectsForAction(ActionType);
-    
-    if (AvailableObjectsForAction.Num() == 0)
+    if (!CurrentTarget)
     {
         UE_LOG(LogTemp, Warning, TEXT("%s: No objects for action %d"), 
                *GetName(), (int32)ActionType);
+        BlockedActionType = ActionType;
         OnMacroActionCompleted(false);
         return;
     }
     
-    CurrentTarget = Cast<AInteractableObject>(AvailableObjectsForAction[0]);
-    
-    float Distance = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
-    UE_LOG(LogTemp, Warning, TEXT("%s: Distance to target: %.2f"), *GetName(), Distance);
-    
-    CurrentTarget->OnInteractionComplete.AddDynamic(this, &ANPCCharacter::OnInteractionComplete);
+    UE_LOG(LogTemp, Warning, TEXT("%s: Expected travel time to target: %.2fs"), *GetName(), ExpectedTravelTime);
     
     CurrentState = ENPCState::MovingToObject;
+    CurrentTravelNode = nullptr;
     UE_LOG(LogTemp, Log, TEXT("%s moving to %s"), *GetName(), *CurrentTarget->GetName());
     
     if (AIController)
@@ -264,7 +504,15 @@ void ANPCCharacter::StartInteractionWithObject()
         return;
     }
     
-    if (!CurrentTarget->CanInteract())
+    if (bQueuedForTarget)
+    {
+        // Дійшли раніше, ніж підійшла черга - OnReservationGranted почне взаємодію
+        CurrentState = ENPCState::WaitingInQueue;
+        QueueWaitStartTime = GetWorld()->GetTimeSeconds();
+        return;
+    }
+    
+    if (!CurrentTarget->CanUserInteract(this))
     {
         UE_LOG(LogTemp, Warning, TEXT("%s: Object became occupied"), *GetName());
         OnMacroActionCompleted(false);
@@ -272,40 +520,38 @@ void ANPCCharacter::StartInteractionWithObject()
     }
 
     CurrentState = ENPCState::Interacting;
+    CurrentTravelNode = CurrentTarget;
     
-    CurrentTarget->StartInteraction(this);
+    CurrentTarget->BeginInteraction(this, NeedsComponent, 
+                                     FOnInteractionFinished::CreateUObject(this, &ANPCCharacter::OnInteractionComplete));
 
     UE_LOG(LogTemp, Log, TEXT("%s started interaction with %s"), 
            *GetName(), *CurrentTarget->GetName());
 }
 
-void ANPCCharacter::OnInteractionComplete(AActor* User)
+void ANPCCharacter::OnInteractionComplete(AInteractableObject* Object)
 {
-    if (User != this)
-    {
-        return;
-    }
-
     UE_LOG(LogTemp, Log, TEXT("%s completed interaction"), *GetName());
 
     TotalActionsPerformed++;
     
     float Reward = CalculateMacroActionReward(true);
     
-    FHighLevelState CurrentStateHL = HighLevelQL->GetCurrentState();
-    HighLevelQL->UpdateQValue(StateBeforeMacroAction, CurrentMacroAction, Reward, CurrentStateHL);
-    
-    UCSVLogger::LogAction(NPCID, Generation, CurrentTarget->ActionType, 
-                         StateBeforeMacroAction.GetStateKey(),
-                         Reward, Lifetime, NeedsComponent->Needs);
+    const float Duration = GetWorld()->GetTimeSeconds() - MacroActionStartTime;
     
-    CurrentState = ENPCState::Idle;
-    if (CurrentTarget)
+    if (HighLevelQL)
     {
-        CurrentTarget->OnInteractionComplete.RemoveDynamic(this, &ANPCCharacter::OnInteractionComplete);
-        CurrentTarget = nullptr;
+        FHighLevelState CurrentStateHL = HighLevelQL->GetCurrentState();
+        HighLevelQL->UpdateQValue(StateBeforeMacroAction, CurrentMacroAction, Reward, CurrentStateHL, Duration);
     }
     
+    UCSVLogger::LogAction(NPCID, Generation, Object->ActionType, 
+                         HighLevelQL ? StateBeforeMacroAction.GetStateKey() : FHighLevelQTable::StateIndexToKey(FrozenStateIndex),
+                         Reward, Lifetime, NeedsComponent->Needs, Duration);
+    
+    CurrentState = ENPCState::Idle;
+    CurrentTarget = nullptr;
+    
     OnMacroActionCompleted(true);
 }
 
@@ -316,48 +562,42 @@ void ANPCCharacter::OnMacroActionCompleted(bool bSuccess)
     if (!bSuccess)
     {
         CurrentState = ENPCState::Idle;
-        if (CurrentTarget)
-        {
-            CurrentTarget->OnInteractionComplete.RemoveDynamic(this, &ANPCCharacter::OnInteractionComplete);
-            CurrentTarget = nullptr;
-        }
+        ReleaseTarget();
     }
     
     float Duration = GetWorld()->GetTimeSeconds() - MacroActionStartTime;
     
     UE_LOG(LogTemp, Log, TEXT("%s macro-action completed: Success=%d, Duration=%.1fs"), 
            *GetName(), bSuccess, Duration);
-}
-
-float ANPCCharacter::CalculateMacroActionReward(bool bSuccess)
-{
-    if (!bSuccess)
-    {
-        return -50.0f;
-    }
     
-    float Reward = 100.0f;
-    
-    ENeedType TargetNeed = (ENeedType)((int32)CurrentMacroAction);
-    float NeedValue = NeedsComponent->GetNeedValue(TargetNeed);
-    
-    if (NeedValue >= 80.0f)
-    {
-        Reward += 50.0f;
-    }
-    
-    for (int32 i = 0; i < (int32)ENeedType::MAX; i++)
+    if (DecisionSubsystem && NeedsComponent && NeedsComponent->bIsAlive)
     {
-        ENeedType Need = (ENeedType)i;
-        float Value = NeedsComponent->GetNeedValue(Need);
-        
-        if (Value < 20.0f)
+        if (BlockedActionType != EActionType::MAX)
+        {
+            DecisionSubsystem->WaitForObject(this, BlockedActionType);
+            BlockedActionType = EActionType::MAX;
+        }
+        else if (!bSuccess)
+        {
+            // Без паузи недосяжна ціль крутила б провал-рішення-провал щокадру
+            const float RetryDelay = FMath::Min(FailureRetryDelay * FMath::Pow(2.0f, (float)FMath::Min(ConsecutiveFailures, 16)), MaxFailureRetryDelay);
+            ConsecutiveFailures++;
+            DecisionSubsystem->RequestDecisionAfter(this, RetryDelay);
+        }
+        else
         {
-            Reward -= 30.0f;
+            ConsecutiveFailures = 0;
+            DecisionSubsystem->RequestDecision(this);
         }
     }
+}
+
+float ANPCCharacter::CalculateMacroActionReward(bool bSuccess)
+{
+    float NeedValues[(int32)ENeedType::MAX];
+    NeedsComponent->GetNeedValues(NeedValues);
     
-    return Reward;
+    return UHighLevelQLearning::CalculateMacroActionReward(CurrentMacroAction, bSuccess, NeedValues);
 }
 
 void ANPCCharacter::OnNPCDied()
@@ -375,14 +615,23 @@ void ANPCCharacter::OnNPCDied()
     UE_LOG(LogTemp, Error, TEXT("%s DIED after %.2f seconds (Generation %d)"), 
            *GetName(), Lifetime, Generation);
     
-    if (bExecutingMacroAction)
+    // Резерв або місце в черзі більше не потрібні
+    if (CurrentState != ENPCState::Interacting)
     {
-        float Reward = -1000.0f;
+        ReleaseTarget();
+    }
+    
+    // Тривалість макро-дії, яку перервала смерть
+    const float ActionDuration = bExecutingMacroAction ? GetWorld()->GetTimeSeconds() - MacroActionStartTime : 0.0f;
+    
+    if (bExecutingMacroAction && HighLevelQL)
+    {
+        float Reward = UHighLevelQLearning::DeathPenalty;
         FHighLevelState DeadState = HighLevelQL->GetCurrentState();
-        HighLevelQL->UpdateQValue(StateBeforeMacroAction, CurrentMacroAction, Reward, DeadState);
+        HighLevelQL->UpdateQValue(StateBeforeMacroAction, CurrentMacroAction, Reward, DeadState, ActionDuration);
     }
     
-    UCSVLogger::LogDeath(NPCID, Generation, Lifetime, NeedsComponent->Needs);
+    UCSVLogger::LogDeath(NPCID, Generation, Lifetime, NeedsComponent->Needs, ActionDuration);
     
     FGenerationStats Stats;
     Stats.GenerationNumber = Generation;
@@ -401,11 +650,22 @@ void ANPCCharacter::OnNPCDied()
 
     UGenerationLogger::LogGeneration(Stats);
     
-    HighLevelQL->SaveQTable("HighLevelQTable.json");
+    if (HighLevelQL)
+    {
+        HighLevelQL->SaveQTable("HighLevelQTable.json");
+    }
     
-    GetWorld()->GetTimerManager().ClearTimer(DecisionTimerHandle);
+    if (DecisionSubsystem)
+    {
+        DecisionSubsystem->CancelDecision(this);
+    }
+    
+    if (!bReturnToPoolOnDeath)
+    {
+        SetLifeSpan(2.0f);
+    }
     
-    SetLifeSpan(2.0f);
+    OnDied.Broadcast(this);
 }
 
 // Старі функції які більше не використовуються (можна видалити)
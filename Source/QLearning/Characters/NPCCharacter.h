@@ -16,7 +16,8 @@ enum class ENPCState : uint8
     Idle,
     Deciding,
     MovingToObject,
-    Interacting
+    Interacting,
+    WaitingInQueue
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNPCDiedSignature, ANPCCharacter*, DeadNPC);
@@ -62,6 +63,47 @@ public:
     
     UPROPERTY()
     float MacroActionStartTime;
+    
+    // Очікуваний час дороги до цілі з кешу навмешу (для duration-aware нагород)
+    UPROPERTY(BlueprintReadOnly, Category = "NPC")
+    float ExpectedTravelTime = 0.0f;
+    
+    // Скомпільована політика (CompiledHighLevelPolicy.h) замість навчання: без UHighLevelQLearning,
+    // таблиці і виділень пам'яті на рішення. Без скомпільованої політики - звичайне навчання
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+    bool bUseFrozenPolicy = false;
+    
+    static bool HasCompiledPolicy();
+    
+    // Черга до зайнятого об'єкта, якщо очікування не довше за це (інакше NPC чекає на будь-який вільний).
+    // Стільки ж NPC максимум стоїть у черзі біля об'єкта, потім вибирає заново
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+    float MaxQueueWaitTime = 20.0f;
+    
+    // Запас до очікуваного часу дороги, після якого резерв знімається
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+    float ReservationSlack = 5.0f;
+    
+    // Пауза перед новим рішенням після провалу (MoveTo, недосяжна ціль); подвоюється з кожним провалом поспіль
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+    float FailureRetryDelay = 0.5f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
+    float MaxFailureRetryDelay = 8.0f;
+    
+    // Вузол матриці шляхів, на якому зараз стоїть NPC (точка спавну або об'єкт)
+    void SetTravelNode(AActor* Node) { CurrentTravelNode = Node; }
+    
+    // Викликається UNPCDecisionSubsystem, коли NPC готовий до нового рішення
+    void MakeDecision();
+    
+    // Пул ANPCSpawnManager: мертвий NPC засинає замість знищення і прокидається як нове покоління
+    void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+    void DeactivateToPool();
+    bool IsDormant() const { return bIsDormant; }
+    
+    UPROPERTY(BlueprintReadOnly, Category = "NPC")
+    bool bReturnToPoolOnDeath = false;
 
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
@@ -76,27 +118,24 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "NPC")
     ENPCState CurrentState = ENPCState::Idle;
     
-    UPROPERTY(BlueprintReadWrite, Category = "NPC")
-    TArray<AInteractableObject*> AvailableObjects;
-    
     UPROPERTY(BlueprintReadOnly, Category = "NPC")
     AInteractableObject* CurrentTarget = nullptr;
     
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NPC")
-    float DecisionInterval = 2.0f;
-
     UPROPERTY(BlueprintReadWrite, Category = "NPC")
     bool bShowNeedsDebug = false;
+    
+    // Після запису статистики смерті; несе сам NPC, тож слухачам не треба нічого шукати
+    UPROPERTY(BlueprintAssignable, Category = "NPC")
+    FOnNPCDiedSignature OnDied;
 
 protected:
     UFUNCTION()
     void OnNPCDied();
 
-    UFUNCTION()
-    void OnInteractionComplete(AActor* User);
+    void OnInteractionComplete(AInteractableObject* Object);
 
-    void MakeDecision();
-    void FindAvailableObjects();
+    void OnNeedLevelChanged(ENeedType NeedType, ENeedLevel NewLevel);
+    
     TArray<EActionType> GetAvailableActions();
     AInteractableObject* FindObjectForAction(EActionType Action);
     void MoveToObject(AInteractableObject* Object);
@@ -106,12 +145,29 @@ protected:
     void OnMoveCompleted(FAIRequestID RequestID, EPathFollowingResult::Type Result);
 
     void ExecuteMacroAction(EMacroAction MacroAction);
+    EMacroAction ChooseFrozenMacroAction();
     void OnMacroActionCompleted(bool bSuccess);
     float CalculateMacroActionReward(bool bSuccess);
-    TArray<AActor*> GetInteractableObjectsForAction(EActionType Action);
+    AInteractableObject* FindBestFreeObject(EActionType Action, float& OutTravelTime) const;
+    AInteractableObject* FindShortestQueueObject(EActionType Action, float& OutTravelTime, float& OutWaitTime) const;
+    void OnReservationGranted(AInteractableObject* Object);
+    void OnReservationFailed(AInteractableObject* Object);
+    void ReleaseTarget();
     
 private:
-    FTimerHandle DecisionTimerHandle;
+    class UInteractableRegistrySubsystem* InteractableRegistry = nullptr;
+    class UTravelCostSubsystem* TravelCost = nullptr;
+    TWeakObjectPtr<AActor> CurrentTravelNode;
+    
+    class UNPCDecisionSubsystem* DecisionSubsystem = nullptr;
+    EActionType BlockedActionType = EActionType::MAX;
+    // Стан останнього рішення замороженої політики (для CSV-логу)
+    int32 FrozenStateIndex = 0;
+    bool bQueuedForTarget = false;
+    float QueueWaitStartTime = 0.0f;
+    int32 ConsecutiveFailures = 0;
+    bool bIsDormant = false;
+
     AAIController* AIController;
     
     FNPCState StateBeforeAction;
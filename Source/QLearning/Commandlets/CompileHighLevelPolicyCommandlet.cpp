@@ -0,0 +1,117 @@
+#include "CompileHighLevelPolicyCommandlet.h"
+#include "../Core/HighLevelQTable.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Algo/StableSort.h"
+
+namespace
+{
+    constexpr int32 ValuesPerLine = 24;
+
+    void AppendArray(FString& Output, const TCHAR* Name, const TArray<uint8>& Values)
+    {
+        Output += FString::Printf(TEXT("    constexpr uint8 %s[%d] = {"), Name, Values.Num());
+        for (int32 Index = 0; Index < Values.Num(); Index++)
+        {
+            if (Index % ValuesPerLine == 0)
+            {
+                Output += TEXT("\n        ");
+            }
+            Output += FString::Printf(TEXT("%d,"), Values[Index]);
+        }
+        Output += TEXT("\n    };\n");
+    }
+}
+
+UCompileHighLevelPolicyCommandlet::UCompileHighLevelPolicyCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UCompileHighLevelPolicyCommandlet::Main(const FString& Params)
+{
+    const int32 NumStates = FHighLevelQTable::NumStates;
+    const int32 NumActions = FHighLevelQTable::NumActions;
+
+    FString InputName = TEXT("HighLevelQTable.json");
+    FParse::Value(*Params, TEXT("Input="), InputName);
+    const FString InputPath = FPaths::ProjectSavedDir() + TEXT("QLearning/") + InputName;
+
+    FString OutputPath = FPaths::GameSourceDir() + TEXT("QLearning/Core/CompiledHighLevelPolicy.h");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    int32 NumFallbacks = 3;
+    FParse::Value(*Params, TEXT("TopK="), NumFallbacks);
+    NumFallbacks = FMath::Clamp(NumFallbacks, 0, NumActions - 1);
+
+    FHighLevelQTable Table;
+    if (!Table.LoadFromFile(InputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CompileHighLevelPolicy: failed to load %s"), *InputPath);
+        return 1;
+    }
+
+    TArray<uint8> GreedyAction;
+    TArray<uint8> FallbackOrder;
+    GreedyAction.SetNumUninitialized(NumStates);
+    FallbackOrder.Reserve(FMath::Max(NumStates * NumFallbacks, 1));
+
+    for (int32 StateIndex = 0; StateIndex < NumStates; StateIndex++)
+    {
+        // Той самий argmax, що й FHighLevelQTable::GetBestAction (нульові рядки -> дія 0)
+        GreedyAction[StateIndex] = (uint8)Table.GetBestAction(StateIndex);
+
+        // Решта дій за спаданням Q, при рівності - за індексом
+        uint8 Order[FHighLevelQTable::NumActions];
+        int32 NumOrdered = 0;
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            if (Action != GreedyAction[StateIndex])
+            {
+                Order[NumOrdered++] = (uint8)Action;
+            }
+        }
+        Algo::StableSort(TArrayView<uint8>(Order, NumOrdered), [&Table, StateIndex](uint8 A, uint8 B)
+        {
+            return Table.GetValue(StateIndex, A) > Table.GetValue(StateIndex, B);
+        });
+
+        for (int32 Rank = 0; Rank < NumFallbacks; Rank++)
+        {
+            FallbackOrder.Add(Order[Rank]);
+        }
+    }
+
+    if (FallbackOrder.Num() == 0)
+    {
+        FallbackOrder.Add(0);
+    }
+
+    FString Output;
+    Output += TEXT("// Згенеровано UCompileHighLevelPolicyCommandlet - не редагувати вручну.\n");
+    Output += FString::Printf(TEXT("// Джерело: %s\n"), *InputName);
+    Output += TEXT("#pragma once\n\n#include \"CoreMinimal.h\"\n\n");
+    Output += TEXT("namespace CompiledHighLevelPolicy\n{\n");
+    Output += FString::Printf(TEXT("    constexpr int32 NumStates = %d;\n"), NumStates);
+    Output += FString::Printf(TEXT("    constexpr int32 NumActions = %d;\n"), NumActions);
+    Output += FString::Printf(TEXT("    constexpr int32 NumFallbacks = %d;\n"), NumFallbacks);
+    Output += FString::Printf(TEXT("    constexpr int32 NumLearnedStates = %d;\n\n"), Table.GetNumStoredStates());
+    Output += TEXT("    // Жадібна дія за упакованим індексом стану (FHighLevelQTable::PackNeedValues)\n");
+    AppendArray(Output, TEXT("GreedyAction"), GreedyAction);
+    Output += TEXT("\n    // Наступні за Q дії: [стан * NumFallbacks + ранг]\n");
+    AppendArray(Output, TEXT("FallbackOrder"), FallbackOrder);
+    Output += TEXT("}\n");
+
+    if (!FFileHelper::SaveStringToFile(Output, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CompileHighLevelPolicy: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ Compiled high-level policy: %d learned states, %d fallbacks per state, Path: %s"),
+           Table.GetNumStoredStates(), NumFallbacks, *OutputPath);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CompileHighLevelPolicyCommandlet.generated.h"
+
+/**
+ * Компілює навчену високорівневу таблицю в constexpr-заголовок для режиму замороженої політики.
+ * UnrealEditor-Cmd QLearning.uproject -run=CompileHighLevelPolicy
+ *     [-Input=HighLevelQTable.json] [-TopK=3] [-Output=<Source/QLearning/Core/CompiledHighLevelPolicy.h>]
+ * TopK - скільки наступних за Q дій зберегти на випадок, коли для жадібної немає вільного об'єкта.
+ */
+UCLASS()
+class QLEARNING_API UCompileHighLevelPolicyCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCompileHighLevelPolicyCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
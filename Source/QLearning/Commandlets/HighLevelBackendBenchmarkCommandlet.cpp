@@ -0,0 +1,193 @@
+#include "HighLevelBackendBenchmarkCommandlet.h"
+#include "../Core/HighLevelQTable.h"
+#include "../Core/HighLevelTileCoding.h"
+#include "../Core/HighLevelDQN.h"
+#include "../Core/HighLevelMLP.h"
+
+namespace
+{
+    constexpr int32 ObservationPoolSize = 4096;
+
+    void LogRate(const TCHAR* Name, int64 NumEvaluations, double Seconds, double TableRate)
+    {
+        const double Rate = Seconds > 0.0 ? NumEvaluations / Seconds : 0.0;
+        UE_LOG(LogTemp, Display, TEXT("BackendBenchmark: %-14s %12.0f evaluations/sec (%.2fx table)"),
+               Name, Rate, TableRate > 0.0 ? Rate / TableRate : 1.0);
+    }
+
+    // Два різні мінібатчі одного розміру: градієнти другого мають збігатися з градієнтами
+    // тієї самої мережі, яка першого не бачила
+    bool CheckGradientIsolation(int32 HiddenSize, int32 Seed)
+    {
+        const int32 NumInputs = FHighLevelValueBackend::NumObservations;
+        const int32 NumOutputs = FHighLevelValueBackend::NumActions;
+        constexpr int32 BatchSize = 8;
+
+        FRandomStream Random(Seed);
+        TArray<float> FirstInputs;
+        TArray<float> SecondInputs;
+        FirstInputs.SetNumUninitialized(BatchSize * NumInputs);
+        SecondInputs.SetNumUninitialized(BatchSize * NumInputs);
+        for (int32 Index = 0; Index < BatchSize * NumInputs; Index++)
+        {
+            FirstInputs[Index] = Random.FRand();
+            SecondInputs[Index] = Random.FRand();
+        }
+
+        // Перший батч пише в інші виходи, ніж другий - саме ці індекси могли лишитися від нього
+        int32 FirstOutputs[BatchSize];
+        int32 SecondOutputs[BatchSize];
+        float Targets[BatchSize];
+        for (int32 Sample = 0; Sample < BatchSize; Sample++)
+        {
+            FirstOutputs[Sample] = NumOutputs - 1;
+            SecondOutputs[Sample] = Sample % (NumOutputs - 1);
+            Targets[Sample] = Random.FRandRange(-50.0f, 50.0f);
+        }
+
+        FHighLevelMLP Trained;
+        FHighLevelMLP Fresh;
+        Trained.Init(NumInputs, HiddenSize, NumOutputs, Seed);
+        Fresh.Init(NumInputs, HiddenSize, NumOutputs, Seed);
+
+        // Нульовий крок не змінює ваг - різниця може прийти тільки з буферів
+        Trained.TrainBatch(FirstInputs.GetData(), FirstOutputs, Targets, BatchSize, 0.0f);
+        Fresh.CopyWeightsFrom(Trained);
+
+        Trained.TrainBatch(SecondInputs.GetData(), SecondOutputs, Targets, BatchSize, 0.0f);
+        Fresh.TrainBatch(SecondInputs.GetData(), SecondOutputs, Targets, BatchSize, 0.0f);
+
+        const TArrayView<const float> TrainedGradients = Trained.GetGradients();
+        const TArrayView<const float> FreshGradients = Fresh.GetGradients();
+        for (int32 Index = 0; Index < TrainedGradients.Num(); Index++)
+        {
+            if (TrainedGradients[Index] != FreshGradients[Index])
+            {
+                UE_LOG(LogTemp, Error, TEXT("BackendBenchmark: MLP gradient %d depends on the previous minibatch (%f vs %f)"),
+                       Index, TrainedGradients[Index], FreshGradients[Index]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+UHighLevelBackendBenchmarkCommandlet::UHighLevelBackendBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UHighLevelBackendBenchmarkCommandlet::Main(const FString& Params)
+{
+    const int32 NumObservations = FHighLevelValueBackend::NumObservations;
+    const int32 NumActions = FHighLevelValueBackend::NumActions;
+
+    int32 NumEvaluations = 1000000;
+    int32 BatchSize = 32;
+    int32 HiddenSize = 32;
+    int32 NumTrainTransitions = 2000;
+    int32 Seed = 0;
+    FParse::Value(*Params, TEXT("Evaluations="), NumEvaluations);
+    FParse::Value(*Params, TEXT("Batch="), BatchSize);
+    FParse::Value(*Params, TEXT("Hidden="), HiddenSize);
+    FParse::Value(*Params, TEXT("Transitions="), NumTrainTransitions);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumEvaluations = FMath::Max(NumEvaluations, 1);
+    BatchSize = FMath::Clamp(BatchSize, 1, ObservationPoolSize);
+
+    // Випадкові спостереження з того самого діапазону, що дає UHighLevelQLearning::GetCurrentState
+    FRandomStream Random(Seed);
+    TArray<float> Observations;
+    Observations.SetNumUninitialized(ObservationPoolSize * NumObservations);
+    for (int32 Index = 0; Index < Observations.Num(); Index++)
+    {
+        Observations[Index] = Index % NumObservations < FHighLevelValueBackend::NumNeeds
+            ? Random.FRandRange(0.0f, 100.0f) : Random.FRand();
+    }
+
+    FHighLevelQTable Table;
+    for (int32 State = 0; State < FHighLevelQTable::NumStates; State++)
+    {
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            Table.SetValueNoVisit(State, Action, Random.FRandRange(-100.0f, 100.0f));
+        }
+    }
+
+    FHighLevelTileCoding TileCoding;
+
+    FHighLevelDQNConfig DQNConfig;
+    DQNConfig.HiddenSize = HiddenSize;
+    DQNConfig.Seed = Seed;
+    FHighLevelDQN DQN(DQNConfig);
+
+    // Сума обраних дій, щоб компілятор не викинув обчислення
+    int64 Checksum = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumEvaluations; i++)
+    {
+        const float* Observation = &Observations[(i % ObservationPoolSize) * NumObservations];
+        Checksum += Table.GetBestAction(FHighLevelQTable::PackNeedValues(Observation));
+    }
+    const double TableSeconds = FPlatformTime::Seconds() - StartTime;
+    const double TableRate = TableSeconds > 0.0 ? NumEvaluations / TableSeconds : 0.0;
+    LogRate(TEXT("Table"), NumEvaluations, TableSeconds, TableRate);
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumEvaluations; i++)
+    {
+        Checksum += TileCoding.GetBestAction(&Observations[(i % ObservationPoolSize) * NumObservations]);
+    }
+    LogRate(TEXT("TileCoding"), NumEvaluations, FPlatformTime::Seconds() - StartTime, TableRate);
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumEvaluations; i++)
+    {
+        Checksum += DQN.GetBestAction(&Observations[(i % ObservationPoolSize) * NumObservations]);
+    }
+    LogRate(TEXT("DQN single"), NumEvaluations, FPlatformTime::Seconds() - StartTime, TableRate);
+
+    TArray<float> BatchValues;
+    BatchValues.SetNumUninitialized(BatchSize * NumActions);
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumEvaluations; i += BatchSize)
+    {
+        const int32 Num = FMath::Min(BatchSize, NumEvaluations - i);
+        const int32 First = (i / BatchSize * BatchSize) % (ObservationPoolSize - BatchSize + 1);
+        DQN.EvaluateBatch(&Observations[First * NumObservations], Num, BatchValues.GetData());
+
+        for (int32 Sample = 0; Sample < Num; Sample++)
+        {
+            Checksum += FHighLevelValueBackend::GetBestOf(&BatchValues[Sample * NumActions]);
+        }
+    }
+    LogRate(*FString::Printf(TEXT("DQN batch %d"), BatchSize), NumEvaluations, FPlatformTime::Seconds() - StartTime, TableRate);
+
+    // Навчання: кожен перехід іде в буфер, мінібатч - раз на TrainEveryTransitions
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumTrainTransitions; i++)
+    {
+        const float* Observation = &Observations[(i % ObservationPoolSize) * NumObservations];
+        const float* NextObservation = &Observations[((i + 1) % ObservationPoolSize) * NumObservations];
+        DQN.Learn(Observation, Random.RandHelper(NumActions), Random.FRandRange(-50.0f, 150.0f), 0.95f, NextObservation, 0.0f);
+    }
+    const double TrainSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Display, TEXT("BackendBenchmark: DQN training %lld minibatches of %d in %.3fs (%.0f minibatches/sec), loss %.3f"),
+           DQN.GetNumTrainSteps(), DQNConfig.BatchSize, TrainSeconds,
+           TrainSeconds > 0.0 ? DQN.GetNumTrainSteps() / TrainSeconds : 0.0, DQN.GetLastLoss());
+
+    UE_LOG(LogTemp, Display, TEXT("BackendBenchmark: hidden %d, checksum %lld"), HiddenSize, Checksum);
+
+    if (!CheckGradientIsolation(HiddenSize, Seed))
+    {
+        return 1;
+    }
+    UE_LOG(LogTemp, Display, TEXT("BackendBenchmark: MLP minibatch gradients are independent of the previous minibatch"));
+    return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HighLevelBackendBenchmarkCommandlet.generated.h"
+
+/**
+ * Порівняння швидкості вибору макро-дії: щільна таблиця, tile coding, DQN поодинці і пакетами.
+ * Наприкінці перевіряє, що градієнти мінібатчу MLP не залежать від попереднього (код виходу 1, якщо залежать).
+ * UnrealEditor-Cmd QLearning.uproject -run=HighLevelBackendBenchmark
+ *     [-Evaluations=1000000] [-Batch=32] [-Hidden=32] [-Transitions=2000] [-Seed=0]
+ */
+UCLASS()
+class QLEARNING_API UHighLevelBackendBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UHighLevelBackendBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,82 @@
+#include "HouseholdTrainingCommandlet.h"
+#include "../Simulation/HouseholdBatchSimulator.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UHouseholdTrainingCommandlet::UHouseholdTrainingCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UHouseholdTrainingCommandlet::Main(const FString& Params)
+{
+    FString MapName;
+    FParse::Value(*Params, TEXT("Map="), MapName);
+
+    UWorld* World = nullptr;
+    if (!MapName.IsEmpty())
+    {
+        UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+        World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+        if (!World)
+        {
+            UE_LOG(LogTemp, Error, TEXT("HouseholdTraining: failed to load map %s"), *MapName);
+            return 1;
+        }
+    }
+
+    FHouseholdSimConfig Config = FHouseholdSimConfig::FromWorld(World);
+    if (Config.Interactables.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("HouseholdTraining: no interactables found, pass -Map=<level>"));
+        return 1;
+    }
+
+    int64 NumDecisions = 10000000;
+    FParse::Value(*Params, TEXT("Envs="), Config.NumEnvironments);
+    FParse::Value(*Params, TEXT("Decisions="), NumDecisions);
+    FParse::Value(*Params, TEXT("Seed="), Config.Seed);
+    FParse::Value(*Params, TEXT("Generation="), Config.StartGeneration);
+
+    FString OutputName = TEXT("HighLevelQTable.json");
+    FParse::Value(*Params, TEXT("Output="), OutputName);
+    const FString OutputPath = FPaths::ProjectSavedDir() + TEXT("QLearning/") + OutputName;
+
+    FHighLevelQTable Table;
+    if (FParse::Param(*Params, TEXT("Warmstart")) && Table.LoadFromFile(OutputPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("HouseholdTraining: warm start from %s (%d states)"),
+               *OutputPath, Table.GetNumStoredStates());
+    }
+
+    FHouseholdBatchSimulator Simulator(Config, Table);
+
+    // Звітуємо приблизно 10 разів за прогін
+    const int64 ReportEvery = FMath::Max<int64>(NumDecisions / 10, Simulator.GetNumEnvironments());
+    while (Simulator.GetTotalDecisions() < NumDecisions)
+    {
+        Simulator.ResetStats();
+        Simulator.Run(FMath::Min(ReportEvery, NumDecisions - Simulator.GetTotalDecisions()));
+
+        UE_LOG(LogTemp, Display, TEXT("HouseholdTraining: %lld decisions, %lld deaths, MeanLifetime=%.1fs, Exploration=%.3f, %.0f env-steps/sec"),
+               Simulator.GetTotalDecisions(), Simulator.GetTotalDeaths(), Simulator.GetMeanLifetime(),
+               Simulator.GetExplorationRate(), Simulator.GetStepsPerSecond());
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("HouseholdTraining: %d envs, %.2fM macro-decisions/min"),
+           Simulator.GetNumEnvironments(), Simulator.GetStepsPerSecond() * 60.0 / 1000000.0);
+
+    if (!Table.SaveToFile(OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("HouseholdTraining: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table saved: %d states, Path: %s"),
+           Table.GetNumStoredStates(), *OutputPath);
+    return 0;
+}
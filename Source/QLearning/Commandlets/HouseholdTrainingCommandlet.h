@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HouseholdTrainingCommandlet.generated.h"
+
+/**
+ * Headless-тренування високорівневої Q-таблиці на FHouseholdBatchSimulator.
+ * UnrealEditor-Cmd QLearning.uproject -run=HouseholdTraining -Map=/Game/ThirdPerson/Lvl_ThirdPerson
+ *     [-Envs=4096] [-Decisions=10000000] [-Seed=0] [-Generation=0] [-Warmstart] [-Output=HighLevelQTable.json]
+ */
+UCLASS()
+class QLEARNING_API UHouseholdTrainingCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UHouseholdTrainingCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
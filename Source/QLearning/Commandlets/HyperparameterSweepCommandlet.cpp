@@ -0,0 +1,112 @@
+#include "HyperparameterSweepCommandlet.h"
+#include "../Simulation/HouseholdSweep.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UHyperparameterSweepCommandlet::UHyperparameterSweepCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UHyperparameterSweepCommandlet::Main(const FString& Params)
+{
+    FString MapName;
+    FParse::Value(*Params, TEXT("Map="), MapName);
+
+    UWorld* World = nullptr;
+    if (!MapName.IsEmpty())
+    {
+        UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+        World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+        if (!World)
+        {
+            UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: failed to load map %s"), *MapName);
+            return 1;
+        }
+    }
+
+    FHouseholdSimConfig Config = FHouseholdSimConfig::FromWorld(World);
+    if (Config.Interactables.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: no interactables found, pass -Map=<level>"));
+        return 1;
+    }
+    Config.NumEnvironments = 1024;
+    FParse::Value(*Params, TEXT("Envs="), Config.NumEnvironments);
+
+    // Осі з -Sweep (через '|') і з -SpecFile (по рядку)
+    TArray<FString> AxisLines;
+    FString SweepText;
+    if (FParse::Value(*Params, TEXT("Sweep="), SweepText, false))
+    {
+        SweepText.ParseIntoArray(AxisLines, TEXT("|"));
+    }
+
+    FString SpecFile;
+    if (FParse::Value(*Params, TEXT("SpecFile="), SpecFile))
+    {
+        TArray<FString> FileLines;
+        if (!FFileHelper::LoadFileToStringArray(FileLines, *SpecFile))
+        {
+            UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: failed to read %s"), *SpecFile);
+            return 1;
+        }
+        for (const FString& Line : FileLines)
+        {
+            if (!Line.TrimStartAndEnd().IsEmpty() && !Line.StartsWith(TEXT("#")))
+            {
+                AxisLines.Add(Line);
+            }
+        }
+    }
+
+    FHouseholdSweepSpec Spec;
+    for (const FString& Line : AxisLines)
+    {
+        FHouseholdSweepAxis Axis;
+        if (!FHouseholdSweepAxis::Parse(Line, Axis))
+        {
+            UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: can't parse axis '%s'"), *Line);
+            return 1;
+        }
+        Spec.Axes.Add(Axis);
+    }
+
+    if (Spec.Axes.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: nothing to sweep, pass -Sweep=\"LearningRate=0.1,0.2,0.4\""));
+        return 1;
+    }
+
+    FParse::Value(*Params, TEXT("Samples="), Spec.NumRandomSamples);
+    FParse::Value(*Params, TEXT("Decisions="), Spec.DecisionsPerConfig);
+    FParse::Value(*Params, TEXT("Checkpoint="), Spec.CheckpointDecisions);
+    FParse::Value(*Params, TEXT("Threshold="), Spec.ThresholdLifetime);
+    FParse::Value(*Params, TEXT("Dominance="), Spec.DominanceRatio);
+    FParse::Value(*Params, TEXT("MinCheckpoints="), Spec.MinCheckpoints);
+    FParse::Value(*Params, TEXT("Seed="), Spec.Seed);
+
+    FString OutputName = TEXT("Sweep.csv");
+    FParse::Value(*Params, TEXT("Output="), OutputName);
+    const FString OutputPath = FPaths::ProjectSavedDir() + TEXT("QLearning/Sweeps/") + OutputName;
+
+    FHouseholdSweep Sweep(Config, Spec);
+    UE_LOG(LogTemp, Warning, TEXT("HyperparameterSweep: %d configurations x %lld decisions, %d envs each"),
+           Sweep.GetResults().Num(), Spec.DecisionsPerConfig, Config.NumEnvironments);
+
+    Sweep.Run();
+
+    if (!Sweep.SaveResults(OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("HyperparameterSweep: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ Sweep results saved: %s"), *OutputPath);
+    return 0;
+}
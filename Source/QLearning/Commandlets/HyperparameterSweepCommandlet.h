@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HyperparameterSweepCommandlet.generated.h"
+
+/**
+ * Паралельний перебір FHLQLearningParams і кривих curriculum на FHouseholdBatchSimulator.
+ * UnrealEditor-Cmd QLearning.uproject -run=HyperparameterSweep -Map=/Game/ThirdPerson/Lvl_ThirdPerson
+ *     -Sweep="LearningRate=0.1,0.2,0.4|ExplorationDecay=0.99:0.9999:log" [-SpecFile=Sweep.txt]
+ *     [-Samples=0] [-Envs=1024] [-Decisions=5000000] [-Checkpoint=250000] [-Threshold=600]
+ *     [-Dominance=0.5] [-MinCheckpoints=3] [-Seed=0] [-Output=Sweep.csv]
+ * -Samples=0 - повна сітка, інакше випадковий пошук; у SpecFile - одна вісь на рядок.
+ */
+UCLASS()
+class QLEARNING_API UHyperparameterSweepCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UHyperparameterSweepCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
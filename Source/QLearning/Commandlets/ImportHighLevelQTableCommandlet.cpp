@@ -0,0 +1,56 @@
+#include "ImportHighLevelQTableCommandlet.h"
+#include "../Core/HighLevelQTableAsset.h"
+#include "../Subsystems/QTableCacheSubsystem.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UImportHighLevelQTableCommandlet::UImportHighLevelQTableCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UImportHighLevelQTableCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    FString InputName = TEXT("HighLevelQTable.json");
+    FParse::Value(*Params, TEXT("Input="), InputName);
+
+    FString PackageName = TEXT("/Game/_Project/QLearning/") + FPaths::GetBaseFilename(InputName);
+    FParse::Value(*Params, TEXT("Asset="), PackageName);
+
+    const FString AssetName = FPackageName::GetLongPackageAssetName(PackageName);
+    UHighLevelQTableAsset* Asset = LoadObject<UHighLevelQTableAsset>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn);
+    if (!Asset)
+    {
+        UPackage* Package = CreatePackage(*PackageName);
+        Asset = NewObject<UHighLevelQTableAsset>(Package, *AssetName, RF_Public | RF_Standalone);
+    }
+
+    Asset->SourceFilename = InputName;
+    if (!Asset->ImportFromFile(UQTableCacheSubsystem::GetTablePath(InputName)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ImportHighLevelQTable: failed to import %s"), *InputName);
+        return 1;
+    }
+
+    UPackage* Package = Asset->GetOutermost();
+    const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    if (!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ImportHighLevelQTable: failed to save %s"), *Filename);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ Imported high-level Q-table: %d states, Asset: %s"), Asset->NumStoredStates, *PackageName);
+    return 0;
+#else
+    return 1;
+#endif
+}
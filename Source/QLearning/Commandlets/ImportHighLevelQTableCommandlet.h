@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ImportHighLevelQTableCommandlet.generated.h"
+
+/**
+ * Імпортує навчену високорівневу таблицю з Saved/QLearning у кукнутий UHighLevelQTableAsset.
+ * UnrealEditor-Cmd QLearning.uproject -run=ImportHighLevelQTable
+ *     [-Input=HighLevelQTable.json] [-Asset=/Game/_Project/QLearning/HighLevelQTable]
+ * Ім'я ассета має збігатися з іменем файлу без розширення - за ним UQTableCacheSubsystem шукає ассет.
+ */
+UCLASS()
+class QLEARNING_API UImportHighLevelQTableCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UImportHighLevelQTableCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,78 @@
+#include "PopulationTrainingCommandlet.h"
+#include "../Simulation/HouseholdPopulationTrainer.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UPopulationTrainingCommandlet::UPopulationTrainingCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UPopulationTrainingCommandlet::Main(const FString& Params)
+{
+    FString MapName;
+    FParse::Value(*Params, TEXT("Map="), MapName);
+
+    UWorld* World = nullptr;
+    if (!MapName.IsEmpty())
+    {
+        UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+        World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+        if (!World)
+        {
+            UE_LOG(LogTemp, Error, TEXT("PopulationTraining: failed to load map %s"), *MapName);
+            return 1;
+        }
+    }
+
+    FHouseholdSimConfig SimConfig = FHouseholdSimConfig::FromWorld(World);
+    if (SimConfig.Interactables.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("PopulationTraining: no interactables found, pass -Map=<level>"));
+        return 1;
+    }
+    SimConfig.NumEnvironments = 1024;
+    FParse::Value(*Params, TEXT("Envs="), SimConfig.NumEnvironments);
+
+    FHouseholdPopulationConfig Config;
+    FParse::Value(*Params, TEXT("Population="), Config.PopulationSize);
+    FParse::Value(*Params, TEXT("Decisions="), Config.DecisionsPerMember);
+    FParse::Value(*Params, TEXT("Interval="), Config.ExploitIntervalDecisions);
+    FParse::Value(*Params, TEXT("Truncation="), Config.TruncationFraction);
+    FParse::Value(*Params, TEXT("Perturb="), Config.PerturbFactor);
+    FParse::Value(*Params, TEXT("Seed="), Config.Seed);
+
+    FString OutputName = TEXT("HighLevelQTable.json");
+    FParse::Value(*Params, TEXT("Output="), OutputName);
+    const FString OutputPath = FPaths::ProjectSavedDir() + TEXT("QLearning/") + OutputName;
+
+    FHouseholdPopulationTrainer Trainer(SimConfig, Config);
+    Trainer.Run();
+
+    const FString HistoryPath = FPaths::ProjectSavedDir() + TEXT("QLearning/Population.csv");
+    if (!Trainer.SaveHistory(HistoryPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("PopulationTraining: failed to write %s"), *HistoryPath);
+    }
+
+    const int32 BestMember = Trainer.GetBestMember();
+    const FHLQLearningParams& Best = Trainer.GetParams(BestMember);
+    UE_LOG(LogTemp, Warning, TEXT("PopulationTraining: best member %d, RollingLifetime=%.1fs, LearningRate=%.4f, DiscountFactor=%.4f, ExplorationRate=%.4f, ExplorationDecay=%.5f, MinExplorationRate=%.4f"),
+           BestMember, Trainer.GetRollingLifetime(BestMember), Best.LearningRate, Best.DiscountFactor,
+           Best.ExplorationRate, Best.ExplorationDecay, Best.MinExplorationRate);
+
+    const FHighLevelQTable& Table = Trainer.GetTable(BestMember);
+    if (!Table.SaveToFile(OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("PopulationTraining: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table saved: %d states, Path: %s"),
+           Table.GetNumStoredStates(), *OutputPath);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PopulationTrainingCommandlet.generated.h"
+
+/**
+ * Population-based training високорівневої таблиці на FHouseholdPopulationTrainer.
+ * UnrealEditor-Cmd QLearning.uproject -run=PopulationTraining -Map=/Game/ThirdPerson/Lvl_ThirdPerson
+ *     [-Population=8] [-Envs=1024] [-Decisions=20000000] [-Interval=500000] [-Truncation=0.25]
+ *     [-Perturb=1.2] [-Seed=0] [-Output=HighLevelQTable.json]
+ * Таблиця найкращого учня йде в Output, історія параметрів - у Saved/QLearning/Population.csv.
+ */
+UCLASS()
+class QLEARNING_API UPopulationTrainingCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UPopulationTrainingCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,95 @@
+#include "QTableCoordinatorCommandlet.h"
+#include "../Core/HighLevelSharedMemoryTable.h"
+#include "../Subsystems/QTableCacheSubsystem.h"
+#include "CoreGlobals.h"
+
+UQTableCoordinatorCommandlet::UQTableCoordinatorCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UQTableCoordinatorCommandlet::Main(const FString& Params)
+{
+    FString RegionName = FHighLevelSharedMemoryTable::DefaultRegionName;
+    FParse::Value(*Params, TEXT("Name="), RegionName);
+
+    FString InputName = TEXT("HighLevelQTable.json");
+    FParse::Value(*Params, TEXT("Input="), InputName);
+
+    FString OutputName = InputName;
+    FParse::Value(*Params, TEXT("Output="), OutputName);
+    const FString OutputPath = UQTableCacheSubsystem::GetTablePath(OutputName);
+
+    float CheckpointSeconds = 60.0f;
+    float DurationSeconds = 0.0f;
+    FParse::Value(*Params, TEXT("CheckpointSeconds="), CheckpointSeconds);
+    FParse::Value(*Params, TEXT("Duration="), DurationSeconds);
+    const bool bExitWhenIdle = FParse::Param(*Params, TEXT("ExitWhenIdle"));
+
+    // Без файлу - навчання з нуля
+    FHighLevelQTable Table;
+    if (Table.LoadFromFile(UQTableCacheSubsystem::GetTablePath(InputName)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("QTableCoordinator: loaded %s (%d states)"), *InputName, Table.GetNumStoredStates());
+    }
+
+    TUniquePtr<FHighLevelSharedMemoryTable> SharedTable = FHighLevelSharedMemoryTable::Create(RegionName, Table);
+    if (!SharedTable)
+    {
+        UE_LOG(LogTemp, Error, TEXT("QTableCoordinator: failed to create shared memory region %s (another coordinator running?)"), *RegionName);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("QTableCoordinator: region %s ready, start instances with -SharedQTable=%s"), *RegionName, *RegionName);
+
+    auto Checkpoint = [&SharedTable, &OutputPath](int64 UpdatesSinceLast, double Seconds)
+    {
+        if (!SharedTable->SaveToFile(OutputPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("QTableCoordinator: failed to write %s"), *OutputPath);
+            return;
+        }
+        UE_LOG(LogTemp, Display, TEXT("QTableCoordinator: checkpoint %s, %lld updates total, %.0f updates/sec, %d processes attached"),
+               *OutputPath, SharedTable->GetTotalUpdates(), UpdatesSinceLast / FMath::Max(Seconds, 0.001),
+               SharedTable->GetNumAttached());
+    };
+
+    const double StartTime = FPlatformTime::Seconds();
+    double LastCheckpointTime = StartTime;
+    int64 LastCheckpointUpdates = SharedTable->GetTotalUpdates();
+    bool bHadInstances = false;
+
+    while (!IsEngineExitRequested())
+    {
+        FPlatformProcess::Sleep(0.5f);
+
+        const double Now = FPlatformTime::Seconds();
+        const int32 NumAttached = SharedTable->GetNumAttached();
+        bHadInstances |= NumAttached > 0;
+
+        if (Now - LastCheckpointTime >= CheckpointSeconds)
+        {
+            const int64 TotalUpdates = SharedTable->GetTotalUpdates();
+            Checkpoint(TotalUpdates - LastCheckpointUpdates, Now - LastCheckpointTime);
+            LastCheckpointTime = Now;
+            LastCheckpointUpdates = TotalUpdates;
+        }
+
+        if ((DurationSeconds > 0.0f && Now - StartTime >= DurationSeconds) ||
+            (bExitWhenIdle && bHadInstances && NumAttached == 0))
+        {
+            break;
+        }
+    }
+
+    // Остання точка - навіть якщо процеси ще вчаться: при виході координатор видаляє ім'я регіону
+    // (і перейнятого теж - Create відкриває його з bCreate = true), нові процеси вже не під'єднаються
+    Checkpoint(SharedTable->GetTotalUpdates() - LastCheckpointUpdates, FPlatformTime::Seconds() - LastCheckpointTime);
+
+    UE_LOG(LogTemp, Warning, TEXT("✅ QTableCoordinator: %lld updates in %.0fs, Path: %s"),
+           SharedTable->GetTotalUpdates(), FPlatformTime::Seconds() - StartTime, *OutputPath);
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "QTableCoordinatorCommandlet.generated.h"
+
+/**
+ * Координатор мультипроцесного навчання: тримає високорівневу таблицю в спільній пам'яті і зберігає контрольні точки.
+ * UnrealEditor-Cmd QLearning.uproject -run=QTableCoordinator
+ *     [-Name=QLearningHighLevel] [-Input=HighLevelQTable.json] [-Output=HighLevelQTable.json]
+ *     [-CheckpointSeconds=60] [-Duration=0] [-ExitWhenIdle]
+ * Ігрові процеси на тому ж хості: QLearning <Map> -game -nullrhi -SharedQTable=QLearningHighLevel
+ * Duration=0 - до Ctrl+C; -ExitWhenIdle - завершитись, коли всі під'єднані процеси від'єдналися.
+ */
+UCLASS()
+class QLEARNING_API UQTableCoordinatorCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UQTableCoordinatorCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
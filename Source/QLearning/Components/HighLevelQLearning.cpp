@@ -1,8 +1,10 @@
 #include "Components/HighLevelQLearning.h"
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
-#include "Json.h"
-#include "JsonUtilities.h"
+#include "../Subsystems/QTableCacheSubsystem.h"
+#include "../Subsystems/HighLevelLearningSubsystem.h"
+#include "../Subsystems/InteractableRegistrySubsystem.h"
+#include "../Core/HighLevelTileCoding.h"
+#include "../Core/HighLevelDQN.h"
+#include "Misc/ScopeLock.h"
 
 UHighLevelQLearning::UHighLevelQLearning()
 {
@@ -14,6 +16,162 @@ void UHighLevelQLearning::BeginPlay()
     Super::BeginPlay();
     
     NeedsComponent = GetOwner()->FindComponentByClass<UNeedsComponent>();
+    InitialParams = Params;
+    
+    LearningSubsystem = GetWorld()->GetSubsystem<UHighLevelLearningSubsystem>();
+    CreateValueBackend();
+    
+    if (!ValueBackend && LearningSubsystem && LearningSubsystem->IsSharedTableEnabled())
+    {
+        SharedTable = &LearningSubsystem->GetSharedTable();
+    }
+    
+    LoadQTable("HighLevelQTable.json");
+    
+    if (SharedTable && Params.bUseEligibilityTraces && LearningSubsystem->IsAsyncLearnerRunning())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("⚠️ %s: eligibility traces are not applied by the async learner"), *GetOwner()->GetName());
+    }
+    
+    CreateExploration();
+    Random.GenerateNewSeed();
+    // Дослідження продовжує спадати з того, що NPC справді завантажив; спільну таблицю рахує підсистема
+    if (!SharedTable)
+    {
+        const int64 LoadedUpdates = ValueBackend ? ValueBackend->GetTotalUpdates() : LocalTable.GetTotalUpdates();
+        if (LearningSubsystem)
+        {
+            LearningSubsystem->SeedOnlineUpdates(LoadedUpdates);
+        }
+        else
+        {
+            NumLocalUpdates = LoadedUpdates;
+        }
+    }
+}
+
+void UHighLevelQLearning::CreateExploration()
+{
+    switch (Params.Exploration)
+    {
+        case EHighLevelExploration::UCB1:
+            Exploration = MakeUnique<FUCB1Exploration>(Params.UCBScale);
+            break;
+            
+        case EHighLevelExploration::Boltzmann:
+            Exploration = MakeUnique<FBoltzmannExploration>(Params.BoltzmannTemperature, 
+                                                            Params.MinBoltzmannTemperature, Params.ExplorationDecay);
+            break;
+            
+        case EHighLevelExploration::CountBonus:
+            Exploration = MakeUnique<FCountBonusExploration>(Params.CountBonusScale);
+            break;
+            
+        default:
+            Exploration = MakeUnique<FEpsilonGreedyExploration>(Params.ExplorationRate, 
+                                                                Params.MinExplorationRate, Params.ExplorationDecay);
+            break;
+    }
+    
+    // Апроксиматори не рахують візитів - стратегіям з лічильниками нема на що спиратися
+    if (ValueBackend && Exploration->NeedsCounts())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("⚠️ %s: exploration %s needs visit counts, falling back to epsilon-greedy"),
+               *GetOwner()->GetName(), *UEnum::GetValueAsString(Params.Exploration));
+        Exploration = MakeUnique<FEpsilonGreedyExploration>(Params.ExplorationRate, 
+                                                            Params.MinExplorationRate, Params.ExplorationDecay);
+    }
+}
+
+int64 UHighLevelQLearning::GetExplorationProgress() const
+{
+    return LearningSubsystem ? LearningSubsystem->GetNumOnlineUpdates() : NumLocalUpdates;
+}
+
+void UHighLevelQLearning::CreateValueBackend()
+{
+    OwnedBackend.Reset();
+    ValueBackend = nullptr;
+    
+    // Headless-процеси мультипроцесного навчання вмикають спільну пам'ять з командного рядка
+    EHighLevelValueBackend Kind = Params.ValueBackend;
+    FString SharedMemoryName = Params.SharedMemoryName;
+    if (FParse::Value(FCommandLine::Get(), TEXT("SharedQTable="), SharedMemoryName))
+    {
+        Kind = EHighLevelValueBackend::SharedMemory;
+    }
+    
+    switch (Kind)
+    {
+        case EHighLevelValueBackend::TileCoding:
+            // Як і мережа - одні ваги на світ, інакше кожен NPC перезаписував би той самий файл своїми
+            if (LearningSubsystem)
+            {
+                ValueBackend = &LearningSubsystem->GetOrCreateTileCoding(Params.NumTilings, Params.TilesPerNeed, Params.TileMemorySize);
+            }
+            else
+            {
+                OwnedBackend = MakeUnique<FHighLevelTileCoding>(Params.NumTilings, Params.TilesPerNeed, Params.TileMemorySize);
+            }
+            break;
+            
+        case EHighLevelValueBackend::DQN:
+        {
+            FHighLevelDQNConfig Config;
+            Config.HiddenSize = Params.DQNHiddenSize;
+            Config.LearningRate = Params.DQNLearningRate;
+            Config.BatchSize = Params.DQNBatchSize;
+            Config.TargetSyncSteps = Params.DQNTargetSyncSteps;
+            
+            // Одна мережа на всіх NPC - тоді рішення кадру можна рахувати одним пакетом
+            if (LearningSubsystem)
+            {
+                ValueBackend = &LearningSubsystem->GetOrCreateDQN(Config);
+            }
+            else
+            {
+                OwnedBackend = MakeUnique<FHighLevelDQN>(Config);
+            }
+            break;
+        }
+            
+        case EHighLevelValueBackend::SharedMemory:
+        {
+            if (LearningSubsystem)
+            {
+                ValueBackend = LearningSubsystem->GetOrAttachSharedMemoryTable(SharedMemoryName);
+            }
+            else
+            {
+                OwnedBackend = FHighLevelSharedMemoryTable::Attach(SharedMemoryName);
+            }
+            
+            // Без координатора - звичайна таблиця з файлу; з підсистемою попередження вже було раз на світ
+            if (!ValueBackend && !OwnedBackend && !LearningSubsystem)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("⚠️ %s: shared Q-table %s not found (is -run=QTableCoordinator running?), using the dense table"),
+                       *GetOwner()->GetName(), *SharedMemoryName);
+            }
+            break;
+        }
+            
+        default:
+            break;
+    }
+    
+    if (OwnedBackend)
+    {
+        ValueBackend = OwnedBackend.Get();
+    }
+}
+
+void UHighLevelQLearning::ResetLearner()
+{
+    Params = InitialParams;
+    PreviousState = FHighLevelState();
+    PreviousAction = EMacroAction::SatisfyHunger;
+    Traces.Reset();
+    ClearPrefetchedValues();
     LoadQTable("HighLevelQTable.json");
 }
 
@@ -25,210 +183,401 @@ FHighLevelState UHighLevelQLearning::GetCurrentState() const
     {
         FNPCState CurrentNPCState = NeedsComponent->GetCurrentState();
         State.NeedLevels = CurrentNPCState.NeedLevels;
+        NeedsComponent->GetNeedValues(State.Observation);
+    }
+    
+    // Об'єктні ознаки потрібні тільки апроксиматорам
+    const UInteractableRegistrySubsystem* Registry = ValueBackend && GetWorld() ? 
+        GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>() : nullptr;
+    if (Registry)
+    {
+        const FVector Location = GetOwner()->GetActorLocation();
+        for (int32 Action = 0; Action < FHighLevelValueBackend::NumActions; Action++)
+        {
+            const EActionType ActionType = GetActionTypeForMacroAction((EMacroAction)Action);
+            
+            float DistSquared = 0.0f;
+            const bool bFound = Registry->FindNearestFree(ActionType, Location, &DistSquared) != nullptr;
+            
+            State.Observation[FHighLevelValueBackend::DistanceOffset + Action] = 
+                bFound ? FMath::Min(FMath::Sqrt(DistSquared) / MaxObservedDistance, 1.0f) : 1.0f;
+            State.Observation[FHighLevelValueBackend::FreeCountOffset + Action] = 
+                FMath::Min(Registry->NumFree(ActionType) / MaxObservedFreeCount, 1.0f);
+        }
     }
     
     return State;
 }
 
-EMacroAction UHighLevelQLearning::ChooseMacroAction(const FHighLevelState& State)
+void UHighLevelQLearning::SetPrefetchedValues(FHighLevelState&& InState, const float* InValues)
 {
-    float RandomValue = FMath::FRand();
-    
-    if (RandomValue < Params.ExplorationRate)
-    {
-        int32 RandomIndex = FMath::RandRange(0, (int32)EMacroAction::MAX - 1);
-        return (EMacroAction)RandomIndex;
-    }
-    else
+    PrefetchedState = MoveTemp(InState);
+    FMemory::Memcpy(PrefetchedValues, InValues, sizeof(PrefetchedValues));
+    bHasPrefetchedValues = true;
+}
+
+FHighLevelState UHighLevelQLearning::GetDecisionState() const
+{
+    return bHasPrefetchedValues ? PrefetchedState : GetCurrentState();
+}
+
+EActionType UHighLevelQLearning::GetActionTypeForMacroAction(EMacroAction MacroAction)
+{
+    switch ((ENeedType)((int32)MacroAction))
     {
-        return GetBestAction(State);
+        case ENeedType::Hunger:   return EActionType::UseRefrigerator;
+        case ENeedType::Bladder:  return EActionType::UseToilet;
+        case ENeedType::Energy:   return EActionType::UseBed;
+        case ENeedType::Social:   return EActionType::UseSofa;
+        case ENeedType::Hygiene:  return EActionType::UseShower;
+        case ENeedType::Fun:      return EActionType::UseTelevision;
+        default:                  return EActionType::Idle;
     }
 }
 
-EMacroAction UHighLevelQLearning::GetBestAction(const FHighLevelState& State) const
+float UHighLevelQLearning::CalculateMacroActionReward(EMacroAction MacroAction, bool bSuccess, 
+                                                      const float* NeedValues)
 {
-    EMacroAction BestAction = EMacroAction::SatisfyHunger;
-    float BestQValue = GetQValue(State, BestAction);
+    if (!bSuccess)
+    {
+        return FailurePenalty;
+    }
     
-    for (int32 i = 0; i < (int32)EMacroAction::MAX; i++)
+    float Reward = 100.0f;
+    
+    if (NeedValues[(int32)MacroAction] >= 80.0f)
     {
-        EMacroAction Action = (EMacroAction)i;
-        float QValue = GetQValue(State, Action);
-        
-        if (QValue > BestQValue)
+        Reward += 50.0f;
+    }
+    
+    for (int32 i = 0; i < (int32)ENeedType::MAX; i++)
+    {
+        if (NeedValues[i] < 20.0f)
         {
-            BestQValue = QValue;
-            BestAction = Action;
+            Reward -= 30.0f;
         }
     }
     
-    return BestAction;
+    return Reward;
 }
 
-void UHighLevelQLearning::UpdateQValue(const FHighLevelState& OldState, 
-                                       EMacroAction Action, 
-                                       float Reward, 
-                                       const FHighLevelState& NewState)
+float UHighLevelQLearning::GetDurationDiscount(const FHLQLearningParams& InParams, float Duration)
 {
-    float CurrentQ = GetQValue(OldState, Action);
-    float MaxNextQ = GetMaxQValue(NewState);
-    
-    float NewQ = CurrentQ + Params.LearningRate * 
-                 (Reward + Params.DiscountFactor * MaxNextQ - CurrentQ);
+    if (!InParams.bUseSMDPDiscount)
+    {
+        return InParams.DiscountFactor;
+    }
     
-    SetQValue(OldState, Action, NewQ);
+    const float TimeUnit = FMath::Max(InParams.SMDPTimeUnit, KINDA_SMALL_NUMBER);
+    return FMath::Pow(InParams.DiscountFactor, FMath::Max(Duration, 0.0f) / TimeUnit);
+}
+
+float UHighLevelQLearning::GetOptionDecayPenalty(const FHLQLearningParams& InParams, float Duration)
+{
+    if (!InParams.bUseSMDPDiscount || Duration <= 0.0f)
+    {
+        return 0.0f;
+    }
     
-    if (Params.ExplorationRate > Params.MinExplorationRate)
+    // Інтеграл c * γ^(t / U) по часу дії: пізніші секунди важать менше
+    float DiscountedSeconds = Duration;
+    const float LogGamma = FMath::Loge(FMath::Max(InParams.DiscountFactor, KINDA_SMALL_NUMBER));
+    if (LogGamma < -KINDA_SMALL_NUMBER)
     {
-        Params.ExplorationRate *= Params.ExplorationDecay;
-        Params.ExplorationRate = FMath::Max(Params.ExplorationRate, Params.MinExplorationRate);
+        const float TimeUnit = FMath::Max(InParams.SMDPTimeUnit, KINDA_SMALL_NUMBER);
+        DiscountedSeconds = TimeUnit * (1.0f - GetDurationDiscount(InParams, Duration)) / -LogGamma;
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("📊 HL Q-Update: State=%s, Action=%d, Reward=%.1f, OldQ=%.1f, NewQ=%.1f, Exploration=%.3f"),
-           *OldState.GetStateKey(), (int32)Action, Reward, CurrentQ, NewQ, Params.ExplorationRate);
+    return -InParams.DecayPenaltyPerSecond * DiscountedSeconds;
 }
 
-float UHighLevelQLearning::GetQValue(const FHighLevelState& State, EMacroAction Action) const
+EMacroAction UHighLevelQLearning::ChooseMacroAction(const FHighLevelState& State)
 {
-    FString StateKey = State.GetStateKey();
+    float Values[FHighLevelValueBackend::NumActions];
+    int32 Counts[FHighLevelValueBackend::NumActions];
+    const float* ValuesPtr = Values;
+    const int32* CountsPtr = nullptr;
+    int32 GreedyAction = INDEX_NONE;
     
-    if (QTable.Contains(StateKey))
+    if (ValueBackend)
+    {
+        GetActionValues(State, Values);
+    }
+    else
     {
-        const FHighLevelActionValues& ActionValues = QTable[StateKey];
-        if (ActionValues.ActionValues.Contains(Action))
+        // Асинхронний учень публікує копію - її читаємо без замків;
+        // інакше фонові повтори пишуть у спільну таблицю з іншого потоку
+        TOptional<FHighLevelPublishedPolicy::FReadScope> Policy;
+        TOptional<FScopeLock> Lock;
+        if (SharedTable && LearningSubsystem->IsAsyncLearnerRunning())
+        {
+            Policy.Emplace(LearningSubsystem->GetPublishedPolicy());
+        }
+        else if (SharedTable)
+        {
+            Lock.Emplace(&LearningSubsystem->GetTableLock());
+        }
+        
+        const FHighLevelQTable& Table = Policy.IsSet() ? Policy->GetTable() : GetTable();
+        const int32 StateIndex = State.GetStateIndex();
+        GreedyAction = Table.GetBestAction(StateIndex);
+        
+        // Epsilon-greedy досить кешованої жадібної дії
+        if (Exploration->NeedsValues() || Exploration->NeedsCounts())
+        {
+            for (int32 Action = 0; Action < FHighLevelQTable::NumActions; Action++)
+            {
+                Values[Action] = Table.GetValue(StateIndex, Action);
+                Counts[Action] = Table.GetUpdates(StateIndex, Action);
+            }
+            CountsPtr = Counts;
+        }
+        else
         {
-            return ActionValues.ActionValues[Action].Value;
+            ValuesPtr = nullptr;
         }
     }
     
-    return 0.0f;
+    return (EMacroAction)Exploration->ChooseAction(ValuesPtr, CountsPtr, GreedyAction, GetExplorationProgress(), Random);
 }
 
-void UHighLevelQLearning::SetQValue(const FHighLevelState& State, EMacroAction Action, float Value)
+void UHighLevelQLearning::GetActionValues(const FHighLevelState& State, float* OutValues) const
 {
-    FString StateKey = State.GetStateKey();
-    
-    if (!QTable.Contains(StateKey))
+    if (bHasPrefetchedValues && 
+        FMemory::Memcmp(PrefetchedState.Observation, State.Observation, sizeof(PrefetchedState.Observation)) == 0)
     {
-        QTable.Add(StateKey, FHighLevelActionValues());
+        FMemory::Memcpy(OutValues, PrefetchedValues, sizeof(PrefetchedValues));
+        return;
+    }
+    ValueBackend->Evaluate(State.Observation, OutValues);
+}
+
+EMacroAction UHighLevelQLearning::GetBestAction(const FHighLevelState& State) const
+{
+    if (ValueBackend)
+    {
+        float Values[FHighLevelValueBackend::NumActions];
+        GetActionValues(State, Values);
+        return (EMacroAction)FHighLevelValueBackend::GetBestOf(Values);
     }
     
-    if (!QTable[StateKey].ActionValues.Contains(Action))
+    if (SharedTable && LearningSubsystem->IsAsyncLearnerRunning())
     {
-        QTable[StateKey].ActionValues.Add(Action, FHighLevelQValue(Value));
+        FHighLevelPublishedPolicy::FReadScope Policy(LearningSubsystem->GetPublishedPolicy());
+        return (EMacroAction)Policy.GetTable().GetBestAction(State.GetStateIndex());
     }
-    else
+    
+    // Читання кешу може перерахувати рядок - під локом спільної таблиці
+    TOptional<FScopeLock> Lock;
+    if (SharedTable)
     {
-        QTable[StateKey].ActionValues[Action].Value = Value;
-        QTable[StateKey].ActionValues[Action].TimesVisited++;
+        Lock.Emplace(&LearningSubsystem->GetTableLock());
     }
+    
+    return (EMacroAction)GetTable().GetBestAction(State.GetStateIndex());
 }
 
-float UHighLevelQLearning::GetMaxQValue(const FHighLevelState& State) const
+void UHighLevelQLearning::UpdateQValue(const FHighLevelState& OldState, 
+                                       EMacroAction Action, 
+                                       float Reward, 
+                                       const FHighLevelState& NewState,
+                                       float Duration)
 {
-    float MaxQ = -999999.0f;
+    float CurrentQ = 0.0f;
+    float NewQ = 0.0f;
+    
+    const float Discount = GetDurationDiscount(Params, Duration);
+    const float TotalReward = Reward + GetOptionDecayPenalty(Params, Duration);
+    
+    FHighLevelTransition Transition;
+    Transition.State = OldState.GetStateIndex();
+    Transition.NextState = NewState.GetStateIndex();
+    Transition.Action = (uint8)Action;
+    Transition.Reward = TotalReward;
+    Transition.Duration = Duration;
+    Transition.Discount = Discount;
+    
+    // Асинхронний учень: на ігровому потоці тільки перехід у черзі, оновлення і повтори - в потоці учня
+    if (SharedTable && LearningSubsystem->IsAsyncLearnerRunning())
+    {
+        LearningSubsystem->EnqueueUpdate(Transition, Params.LearningRate);
+        LearningSubsystem->NotifyOnlineUpdate();
+        return;
+    }
     
-    for (int32 i = 0; i < (int32)EMacroAction::MAX; i++)
+    if (ValueBackend)
     {
-        EMacroAction Action = (EMacroAction)i;
-        float QValue = GetQValue(State, Action);
-        if (QValue > MaxQ)
+        CurrentQ = GetQValue(OldState, Action);
+        ValueBackend->Learn(OldState.Observation, (int32)Action, TotalReward, Discount, 
+                            NewState.Observation, Params.LearningRate);
+        NewQ = GetQValue(OldState, Action);
+    }
+    else
+    {
+        TOptional<FScopeLock> Lock;
+        if (SharedTable)
+        {
+            Lock.Emplace(&LearningSubsystem->GetTableLock());
+        }
+        
+        CurrentQ = GetQValue(OldState, Action);
+        float MaxNextQ = GetMaxQValue(NewState);
+        
+        const float Delta = TotalReward + Discount * MaxNextQ - CurrentQ;
+        NewQ = CurrentQ + Params.LearningRate * Delta;
+        
+        if (Params.bUseEligibilityTraces)
         {
-            MaxQ = QValue;
+            const int32 StateIndex = OldState.GetStateIndex();
+            const int32 Slot = StateIndex * FHighLevelQTable::NumActions + (int32)Action;
+            
+            // Жадібна дія продовжує ланцюжок, дослідницька чи аварійна - обриває
+            if ((int32)Action == GetTable().GetBestAction(StateIndex))
+            {
+                Traces.Decay(Discount * Params.TraceLambda);
+            }
+            else
+            {
+                Traces.Reset();
+            }
+            
+            Traces.Replace(Slot);
+            Traces.Apply(GetMutableTable(), Params.LearningRate, Delta, Slot);
         }
+        
+        SetQValue(OldState, Action, NewQ);
+    }
+    
+    if (LearningSubsystem)
+    {
+        LearningSubsystem->NotifyOnlineUpdate();
+    }
+    else
+    {
+        NumLocalUpdates++;
     }
     
-    return MaxQ == -999999.0f ? 0.0f : MaxQ;
+    // Повтори мають сенс тільки для спільної таблиці
+    if (SharedTable)
+    {
+        LearningSubsystem->AddTransition(Transition, Params.LearningRate);
+    }
+    
+    UE_LOG(LogTemp, Warning, TEXT("📊 HL Q-Update: State=%s, Action=%d, Reward=%.1f, Duration=%.1fs, Discount=%.3f, OldQ=%.1f, NewQ=%.1f, Exploration=%.3f"),
+           *OldState.GetStateKey(), (int32)Action, TotalReward, Duration, Discount, CurrentQ, NewQ, 
+           Exploration->GetScheduleValue(GetExplorationProgress()));
 }
 
-void UHighLevelQLearning::SaveQTable(const FString& Filename)
+float UHighLevelQLearning::GetQValue(const FHighLevelState& State, EMacroAction Action) const
 {
-    FString SaveDirectory = FPaths::ProjectSavedDir() + TEXT("QLearning/");
-    FString FullPath = SaveDirectory + Filename;
-
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*SaveDirectory))
+    if (ValueBackend)
     {
-        PlatformFile.CreateDirectory(*SaveDirectory);
+        float Values[FHighLevelValueBackend::NumActions];
+        ValueBackend->Evaluate(State.Observation, Values);
+        return Values[(int32)Action];
     }
+    
+    return GetTable().GetValue(State.GetStateIndex(), (int32)Action);
+}
 
-    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+void UHighLevelQLearning::SetQValue(const FHighLevelState& State, EMacroAction Action, float Value)
+{
+    GetMutableTable().SetValue(State.GetStateIndex(), (int32)Action, Value);
+}
+
+float UHighLevelQLearning::GetMaxQValue(const FHighLevelState& State) const
+{
+    if (ValueBackend)
+    {
+        return ValueBackend->GetMaxValue(State.Observation);
+    }
     
-    for (const auto& StatePair : QTable)
+    // Відсутні значення - нулі, як і в старій TMap-таблиці
+    return GetTable().GetMaxValue(State.GetStateIndex());
+}
+
+void UHighLevelQLearning::SaveQTable(const FString& Filename)
+{
+    if (ValueBackend)
     {
-        TSharedPtr<FJsonObject> StateObject = MakeShareable(new FJsonObject);
-        
-        for (const auto& ActionPair : StatePair.Value.ActionValues)
+        const FString BackendPath = UQTableCacheSubsystem::GetTablePath(ValueBackend->GetFileName());
+        if (ValueBackend->SaveToFile(BackendPath))
         {
-            TSharedPtr<FJsonObject> QValueObject = MakeShareable(new FJsonObject);
-            QValueObject->SetNumberField("Value", ActionPair.Value.Value);
-            QValueObject->SetNumberField("TimesVisited", ActionPair.Value.TimesVisited);
-            
-            StateObject->SetObjectField(FString::FromInt((int32)ActionPair.Key), QValueObject);
+            UE_LOG(LogTemp, Warning, TEXT("✅ High-Level value backend saved: %s"), *BackendPath);
         }
-        
-        RootObject->SetObjectField(StatePair.Key, StateObject);
+        return;
+    }
+    
+    FString FullPath = UQTableCacheSubsystem::GetTablePath(Filename);
+    
+    // Зберігає потік учня, після вже поставлених у чергу оновлень; кеш світу спільній таблиці не потрібен
+    if (SharedTable && LearningSubsystem->IsAsyncLearnerRunning())
+    {
+        LearningSubsystem->RequestSave(FullPath);
+        return;
+    }
+    
+    // Під замком лише копія: JSON і запис на диск не мають зупиняти планувальник і повтори
+    FHighLevelQTable SharedSnapshot;
+    if (SharedTable)
+    {
+        FScopeLock Lock(&LearningSubsystem->GetTableLock());
+        SharedSnapshot = *SharedTable;
+    }
+    
+    const FHighLevelQTable& Table = SharedTable ? SharedSnapshot : LocalTable;
+    Table.SaveToFile(FullPath);
+    
+    if (UQTableCacheSubsystem* Cache = GetWorld() ? GetWorld()->GetSubsystem<UQTableCacheSubsystem>() : nullptr)
+    {
+        Cache->Store(Filename, Table);
     }
-
-    FString OutputString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
-
-    FFileHelper::SaveStringToFile(OutputString, *FullPath);
     
     UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table saved: %d states, Path: %s"), 
-           QTable.Num(), *FullPath);
+           Table.GetNumStoredStates(), *FullPath);
 }
 
 void UHighLevelQLearning::LoadQTable(const FString& Filename)
 {
-    FString LoadDirectory = FPaths::ProjectSavedDir() + TEXT("QLearning/");
-    FString FullPath = LoadDirectory + Filename;
-
-    FString JsonString;
-    if (!FFileHelper::LoadFileToString(JsonString, *FullPath))
+    // Спільні ваги завантажує підсистема
+    if (ValueBackend && !OwnedBackend)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Could not load High-Level Q-Table from: %s"), *FullPath);
         return;
     }
-
-    TSharedPtr<FJsonObject> RootObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-
-    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+    
+    if (ValueBackend)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to parse High-Level Q-Table JSON"));
+        ValueBackend->Reset();
+        const FString BackendPath = UQTableCacheSubsystem::GetTablePath(ValueBackend->GetFileName());
+        if (!ValueBackend->LoadFromFile(BackendPath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Could not load High-Level value backend from: %s"), *BackendPath);
+        }
         return;
     }
-
-    QTable.Empty();
-
-    for (const auto& StatePair : RootObject->Values)
+    
+    // Спільна таблиця вже завантажена підсистемою і живе весь час гри
+    if (SharedTable)
     {
-        FString StateKey = StatePair.Key;
-        FHighLevelActionValues ActionValues;
-        
-        const TSharedPtr<FJsonObject>* StateObject;
-        if (StatePair.Value->TryGetObject(StateObject))
+        return;
+    }
+    
+    // В грі файл розбирається один раз на світ
+    if (UQTableCacheSubsystem* Cache = GetWorld() ? GetWorld()->GetSubsystem<UQTableCacheSubsystem>() : nullptr)
+    {
+        if (const FHighLevelQTable* Cached = Cache->FindOrLoad(Filename))
         {
-            for (const auto& ActionPair : (*StateObject)->Values)
-            {
-                EMacroAction Action = (EMacroAction)FCString::Atoi(*ActionPair.Key);
-                
-                const TSharedPtr<FJsonObject>* QValueObject;
-                if (ActionPair.Value->TryGetObject(QValueObject))
-                {
-                    FHighLevelQValue QValue;
-                    QValue.Value = (*QValueObject)->GetNumberField("Value");
-                    QValue.TimesVisited = (*QValueObject)->GetIntegerField("TimesVisited");
-                    
-                    ActionValues.ActionValues.Add(Action, QValue);
-                }
-            }
+            LocalTable = *Cached;
         }
-        
-        QTable.Add(StateKey, ActionValues);
+        return;
+    }
+    
+    FString FullPath = UQTableCacheSubsystem::GetTablePath(Filename);
+    if (!LocalTable.LoadFromFile(FullPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not load High-Level Q-Table from: %s"), *FullPath);
+        return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table loaded: %d states"), QTable.Num());
-}
\ No newline at end of file
+    UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table loaded: %d states"), LocalTable.GetNumStoredStates());
+}
@@ -3,6 +3,11 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "NeedsComponent.h"
+#include "../Core/HighLevelQTable.h"
+#include "../Core/HighLevelEligibilityTraces.h"
+#include "../Core/HighLevelValueBackend.h"
+#include "../Core/HighLevelExploration.h"
+#include "../Core/HighLevelSharedMemoryTable.h"
 #include "HighLevelQLearning.generated.h"
 
 // Високорівневі дії (macro-actions)
@@ -26,6 +31,18 @@ struct FHighLevelState
     
     TMap<ENeedType, ENeedLevel> NeedLevels;
     
+    // Неперервне спостереження для апроксимації (розкладка - FHighLevelValueBackend)
+    float Observation[FHighLevelValueBackend::NumObservations];
+    
+    FHighLevelState()
+    {
+        for (int32 i = 0; i < FHighLevelValueBackend::NumObservations; i++)
+        {
+            Observation[i] = i < FHighLevelValueBackend::NumNeeds ? 50.0f : 
+                             i < FHighLevelValueBackend::FreeCountOffset ? 1.0f : 0.0f;
+        }
+    }
+    
     FString GetStateKey() const
     {
         FString Key = "";
@@ -43,30 +60,36 @@ struct FHighLevelState
         }
         return Key;
     }
+    
+    // Індекс у FHighLevelQTable, еквівалентний GetStateKey()
+    int32 GetStateIndex() const
+    {
+        ENeedLevel Levels[FHighLevelQTable::NumNeeds];
+        for (int32 i = 0; i < FHighLevelQTable::NumNeeds; i++)
+        {
+            const ENeedLevel* Level = NeedLevels.Find((ENeedType)i);
+            Levels[i] = Level ? *Level : ENeedLevel::Medium;
+        }
+        return FHighLevelQTable::PackLevels(Levels);
+    }
 };
 
-USTRUCT()
-struct FHighLevelQValue
+UENUM()
+enum class EHighLevelValueBackend : uint8
 {
-    GENERATED_BODY()
-    
-    UPROPERTY()
-    float Value = 0.0f;
-    
-    UPROPERTY()
-    int32 TimesVisited = 0;
-    
-    FHighLevelQValue() : Value(0.0f), TimesVisited(0) {}
-    FHighLevelQValue(float InValue) : Value(InValue), TimesVisited(0) {}
+    Table       UMETA(DisplayName = "Dense Table"),
+    TileCoding  UMETA(DisplayName = "Tile Coding"),
+    DQN         UMETA(DisplayName = "Neural Network (DQN)"),
+    SharedMemory UMETA(DisplayName = "Shared Memory Table (multi-process)"),
 };
 
-USTRUCT()
-struct FHighLevelActionValues
+UENUM()
+enum class EHighLevelExploration : uint8
 {
-    GENERATED_BODY()
-    
-    UPROPERTY()
-    TMap<EMacroAction, FHighLevelQValue> ActionValues;
+    EpsilonGreedy   UMETA(DisplayName = "Epsilon-Greedy"),
+    UCB1            UMETA(DisplayName = "UCB1"),
+    Boltzmann       UMETA(DisplayName = "Boltzmann (Softmax)"),
+    CountBonus      UMETA(DisplayName = "Count-Based Bonus"),
 };
 
 USTRUCT()
@@ -80,6 +103,12 @@ struct FHLQLearningParams
     UPROPERTY(EditAnywhere)
     float DiscountFactor = 0.95f;
     
+    // Графіки ExplorationDecay і BoltzmannTemperature йдуть за глобальною кількістю оновлень
+    // (UHighLevelLearningSubsystem), а не за віком окремого NPC
+    UPROPERTY(EditAnywhere)
+    EHighLevelExploration Exploration = EHighLevelExploration::EpsilonGreedy;
+    
+    // Початковий epsilon
     UPROPERTY(EditAnywhere)
     float ExplorationRate = 0.8f;
     
@@ -88,6 +117,69 @@ struct FHLQLearningParams
     
     UPROPERTY(EditAnywhere)
     float MinExplorationRate = 0.1f;
+    
+    // Ваги бонусів у одиницях Q (нагорода за успішну дію - 100)
+    UPROPERTY(EditAnywhere)
+    float UCBScale = 50.0f;
+    
+    UPROPERTY(EditAnywhere)
+    float CountBonusScale = 50.0f;
+    
+    UPROPERTY(EditAnywhere)
+    float BoltzmannTemperature = 20.0f;
+    
+    UPROPERTY(EditAnywhere)
+    float MinBoltzmannTemperature = 1.0f;
+    
+    // Watkins Q(λ): нагорода доходить до попередніх рішень життя, сліди обриваються після дослідницької дії
+    UPROPERTY(EditAnywhere)
+    bool bUseEligibilityTraces = false;
+    
+    UPROPERTY(EditAnywhere)
+    float TraceLambda = 0.8f;
+    
+    // Semi-MDP: дисконт γ^(тривалість / SMDPTimeUnit) замість одного γ на макро-дію
+    UPROPERTY(EditAnywhere)
+    bool bUseSMDPDiscount = false;
+    
+    // Скільки секунд макро-дії відповідає одному кроку γ
+    UPROPERTY(EditAnywhere)
+    float SMDPTimeUnit = 10.0f;
+    
+    // Штраф за кожну секунду дії (потреби деградують, поки NPC іде і чекає)
+    UPROPERTY(EditAnywhere)
+    float DecayPenaltyPerSecond = 1.0f;
+    
+    // Не-табличні варіанти без спільної таблиці, повторів і слідів. Tile coding - копія NPC,
+    // DQN - одна мережа на світ в UHighLevelLearningSubsystem
+    UPROPERTY(EditAnywhere)
+    EHighLevelValueBackend ValueBackend = EHighLevelValueBackend::Table;
+    
+    UPROPERTY(EditAnywhere)
+    int32 NumTilings = 8;
+    
+    // Роздільність сітки; пам'ять задає тільки TileMemorySize
+    UPROPERTY(EditAnywhere)
+    int32 TilesPerNeed = 10;
+    
+    UPROPERTY(EditAnywhere)
+    int32 TileMemorySize = 4096;
+    
+    UPROPERTY(EditAnywhere)
+    int32 DQNHiddenSize = 32;
+    
+    UPROPERTY(EditAnywhere)
+    float DQNLearningRate = 0.001f;
+    
+    UPROPERTY(EditAnywhere)
+    int32 DQNBatchSize = 32;
+    
+    UPROPERTY(EditAnywhere)
+    int32 DQNTargetSyncSteps = 250;
+    
+    // Регіон, який створив -run=QTableCoordinator; -SharedQTable=<ім'я> в командному рядку вмикає цей бекенд
+    UPROPERTY(EditAnywhere)
+    FString SharedMemoryName = FHighLevelSharedMemoryTable::DefaultRegionName;
 };
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
@@ -102,9 +194,24 @@ public:
     
     EMacroAction ChooseMacroAction(const FHighLevelState& State);
     void UpdateQValue(const FHighLevelState& OldState, EMacroAction Action, 
-                     float Reward, const FHighLevelState& NewState);
+                     float Reward, const FHighLevelState& NewState, float Duration = 0.0f);
     
     FHighLevelState GetCurrentState() const;
+    
+    // Спільні правила середовища - їх використовують і NPC, і headless-симулятор
+    static EActionType GetActionTypeForMacroAction(EMacroAction MacroAction);
+    static float CalculateMacroActionReward(EMacroAction MacroAction, bool bSuccess, const float* NeedValues);
+    
+    // Без bUseSMDPDiscount - звичайний DiscountFactor і нульовий штраф
+    static float GetDurationDiscount(const FHLQLearningParams& InParams, float Duration);
+    static float GetOptionDecayPenalty(const FHLQLearningParams& InParams, float Duration);
+    
+    // Нормування об'єктних ознак спостереження
+    static constexpr float MaxObservedDistance = 3000.0f;
+    static constexpr float MaxObservedFreeCount = 4.0f;
+    
+    static constexpr float FailurePenalty = -50.0f;
+    static constexpr float DeathPenalty = -1000.0f;
     float GetQValue(const FHighLevelState& State, EMacroAction Action) const;
     void SetQValue(const FHighLevelState& State, EMacroAction Action, float Value);
     float GetMaxQValue(const FHighLevelState& State) const;
@@ -113,11 +220,32 @@ public:
     void SaveQTable(const FString& Filename);
     void LoadQTable(const FString& Filename);
     
+    // Спільна таблиця UHighLevelLearningSubsystem або власна копія NPC
+    const FHighLevelQTable& GetTable() const { return SharedTable ? *SharedTable : LocalTable; }
+    bool UsesSharedTable() const { return SharedTable != nullptr; }
+    
+    // nullptr, якщо Q зберігається в таблиці
+    const FHighLevelValueBackend* GetValueBackend() const { return ValueBackend; }
+    bool UsesSharedValueBackend() const { return ValueBackend && !OwnedBackend; }
+    
+    // Кількість онлайн-оновлень, за якою спадають графіки дослідження
+    int64 GetExplorationProgress() const;
+    
+    // Q, пораховані пакетом для всіх NPC кадру (UNPCDecisionSubsystem); діють, поки спостереження те саме
+    void SetPrefetchedValues(FHighLevelState&& InState, const float* InValues);
+    void ClearPrefetchedValues() { bHasPrefetchedValues = false; }
+    
+    // Стан, для якого пакет уже порахував Q, - без повторних запитів до реєстру; інакше GetCurrentState
+    FHighLevelState GetDecisionState() const;
+    
+    // Нове життя NPC з пулу: початкові параметри дослідження; власна копія таблиці перечитується
+    void ResetLearner();
+    
     UPROPERTY(EditAnywhere, Category = "Q-Learning")
     FHLQLearningParams Params;
     
     UPROPERTY()
-    TMap<FString, FHighLevelActionValues> QTable;
+    FHLQLearningParams InitialParams;
     
     UPROPERTY()
     class UNeedsComponent* NeedsComponent;
@@ -127,4 +255,29 @@ public:
     
     UPROPERTY()
     EMacroAction PreviousAction;
+
+private:
+    FHighLevelQTable& GetMutableTable() { return SharedTable ? *SharedTable : LocalTable; }
+    void CreateValueBackend();
+    void CreateExploration();
+    // Q апроксиматора; пораховані пакетом значення беруться без повторного виводу
+    void GetActionValues(const FHighLevelState& State, float* OutValues) const;
+    
+    FHighLevelQTable LocalTable;
+    FHighLevelQTable* SharedTable = nullptr;
+    FHighLevelEligibilityTraces Traces;
+    FHighLevelValueBackend* ValueBackend = nullptr;
+    TUniquePtr<FHighLevelValueBackend> OwnedBackend;
+    
+    TUniquePtr<FHighLevelExploration> Exploration;
+    FRandomStream Random;
+    // Без підсистеми (headless-тести компонента) - власний лічильник
+    int64 NumLocalUpdates = 0;
+    
+    FHighLevelState PrefetchedState;
+    float PrefetchedValues[FHighLevelValueBackend::NumActions];
+    bool bHasPrefetchedValues = false;
+    
+    UPROPERTY()
+    class UHighLevelLearningSubsystem* LearningSubsystem = nullptr;
 };
\ No newline at end of file
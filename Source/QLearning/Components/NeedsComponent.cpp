@@ -14,6 +14,11 @@ void UNeedsComponent::BeginPlay()
 {
     Super::BeginPlay();
     
+    ResetNeeds();
+}
+
+void UNeedsComponent::ResetNeeds()
+{
     float StartValue = CalculateStartValue(CurrentGeneration);
     
     Needs.Empty();
@@ -62,8 +67,15 @@ void UNeedsComponent::DegradeNeeds(float DeltaTime)
         
         if (NewValue != NeedPair.Value)
         {
+            const ENeedLevel OldLevel = FNPCState::ValueToLevel(NeedPair.Value);
             Needs[NeedPair.Key] = NewValue;
             OnNeedChanged.Broadcast(NeedPair.Key, NewValue);
+            
+            const ENeedLevel NewLevel = FNPCState::ValueToLevel(NewValue);
+            if (NewLevel != OldLevel)
+            {
+                OnNeedLevelChanged.Broadcast(NeedPair.Key, NewLevel);
+            }
         }
     }
 }
@@ -91,6 +103,12 @@ void UNeedsComponent::ModifyNeed(ENeedType NeedType, float Amount)
     
     Needs[NeedType] = NewValue;
     OnNeedChanged.Broadcast(NeedType, NewValue);
+    
+    const ENeedLevel NewLevel = FNPCState::ValueToLevel(NewValue);
+    if (NewLevel != FNPCState::ValueToLevel(CurrentValue))
+    {
+        OnNeedLevelChanged.Broadcast(NeedType, NewLevel);
+    }
 }
 
 float UNeedsComponent::GetNeedValue(ENeedType NeedType) const
@@ -102,6 +120,14 @@ float UNeedsComponent::GetNeedValue(ENeedType NeedType) const
     return 0.0f;
 }
 
+void UNeedsComponent::GetNeedValues(float* OutValues) const
+{
+    for (int32 i = 0; i < (int32)ENeedType::MAX; i++)
+    {
+        OutValues[i] = GetNeedValue((ENeedType)i);
+    }
+}
+
 FNPCState UNeedsComponent::GetCurrentState() const
 {
     FNPCState State;
@@ -8,6 +8,7 @@
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNeedChanged, ENeedType, NeedType, float, NewValue);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnNPCDied);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNeedLevelChanged, ENeedType, ENeedLevel);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class QLEARNING_API UNeedsComponent : public UActorComponent
@@ -36,6 +37,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Needs")
     FOnNPCDied OnNPCDied;
     
+    // Тільки коли потреба переходить в інший ENeedLevel (тобто змінюється високорівневий стан)
+    FOnNeedLevelChanged OnNeedLevelChanged;
+    
     UPROPERTY(BlueprintReadOnly, Category = "Needs")
     bool bIsAlive = true;
     
@@ -48,6 +52,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Needs")
     FNPCState GetCurrentState() const;
 
+    // Значення в порядку ENeedType, OutValues має вміщати ENeedType::MAX елементів
+    void GetNeedValues(float* OutValues) const;
+
+    // Стартові значення і bIsAlive для CurrentGeneration (BeginPlay та повторне використання з пулу)
+    UFUNCTION(BlueprintCallable, Category = "Needs")
+    void ResetNeeds();
+
     UFUNCTION(BlueprintCallable, Category = "Needs")
     void InitializeNeeds(float MinValue = 70.0f, float MaxValue = 80.0f);
 
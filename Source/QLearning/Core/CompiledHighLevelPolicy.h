@@ -0,0 +1,20 @@
+// Згенеровано UCompileHighLevelPolicyCommandlet - не редагувати вручну.
+// Політику ще не скомпільовано: -run=CompileHighLevelPolicy -Input=HighLevelQTable.json
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace CompiledHighLevelPolicy
+{
+    // 0 - масиви порожні, режим замороженої політики недоступний
+    constexpr int32 NumStates = 0;
+    constexpr int32 NumActions = 0;
+    constexpr int32 NumFallbacks = 0;
+    constexpr int32 NumLearnedStates = 0;
+
+    // Жадібна дія за упакованим індексом стану (FHighLevelQTable::PackNeedValues)
+    constexpr uint8 GreedyAction[1] = { 0 };
+
+    // Наступні за Q дії: [стан * NumFallbacks + ранг]
+    constexpr uint8 FallbackOrder[1] = { 0 };
+}
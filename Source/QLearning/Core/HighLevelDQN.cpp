@@ -0,0 +1,193 @@
+#include "HighLevelDQN.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+    constexpr uint32 DQNMagic = 0x4E4E4C51; // "QLNN"
+    constexpr int32 DQNVersion = 1;
+}
+
+FHighLevelDQN::FHighLevelDQN(const FHighLevelDQNConfig& InConfig)
+    : Config(InConfig)
+{
+    Config.BatchSize = FMath::Max(Config.BatchSize, 1);
+    Config.ReplayCapacity = FMath::Max(Config.ReplayCapacity, Config.BatchSize);
+    Config.TrainEveryTransitions = FMath::Max(Config.TrainEveryTransitions, 1);
+    Config.TargetSyncSteps = FMath::Max(Config.TargetSyncSteps, 1);
+
+    Reset();
+}
+
+void FHighLevelDQN::Reset()
+{
+    Online.Init(NumObservations, Config.HiddenSize, NumActions, Config.Seed);
+    Target.Init(NumObservations, Config.HiddenSize, NumActions, Config.Seed);
+    Target.CopyWeightsFrom(Online);
+    Random.Initialize(Config.Seed);
+
+    // Уся пам'ять буфера виділяється тут
+    ReplayObservations.SetNumZeroed(Config.ReplayCapacity * NumObservations);
+    ReplayNextObservations.SetNumZeroed(Config.ReplayCapacity * NumObservations);
+    ReplayRewards.SetNumZeroed(Config.ReplayCapacity);
+    ReplayDiscounts.SetNumZeroed(Config.ReplayCapacity);
+    ReplayActions.SetNumZeroed(Config.ReplayCapacity);
+    ReplayHead = 0;
+    ReplayNum = 0;
+    TransitionsSinceTrain = 0;
+
+    InputScratch.SetNumUninitialized(Config.BatchSize * NumObservations);
+    NextInputScratch.SetNumUninitialized(Config.BatchSize * NumObservations);
+    NextValueScratch.SetNumUninitialized(Config.BatchSize * NumActions);
+    TargetScratch.SetNumUninitialized(Config.BatchSize);
+    DiscountScratch.SetNumUninitialized(Config.BatchSize);
+    ActionScratch.SetNumUninitialized(Config.BatchSize);
+
+    NumTrainSteps = 0;
+    LastLoss = 0.0f;
+}
+
+void FHighLevelDQN::Normalize(const float* Observation, float* OutInputs)
+{
+    for (int32 Index = 0; Index < NumObservations; Index++)
+    {
+        OutInputs[Index] = Index < NumNeeds ? Observation[Index] * 0.01f : Observation[Index];
+    }
+}
+
+void FHighLevelDQN::Evaluate(const float* Observation, float* OutValues) const
+{
+    float Inputs[NumObservations];
+    Normalize(Observation, Inputs);
+    Online.Forward(Inputs, 1, OutValues);
+}
+
+void FHighLevelDQN::EvaluateBatch(const float* Observations, int32 Num, float* OutValues) const
+{
+    InputScratch.SetNumUninitialized(FMath::Max(Num * NumObservations, InputScratch.Num()), EAllowShrinking::No);
+    for (int32 Sample = 0; Sample < Num; Sample++)
+    {
+        Normalize(Observations + Sample * NumObservations, InputScratch.GetData() + Sample * NumObservations);
+    }
+
+    Online.Forward(InputScratch.GetData(), Num, OutValues);
+}
+
+void FHighLevelDQN::Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                          const float* NextObservation, float Alpha)
+{
+    Normalize(Observation, &ReplayObservations[ReplayHead * NumObservations]);
+    Normalize(NextObservation, &ReplayNextObservations[ReplayHead * NumObservations]);
+    ReplayRewards[ReplayHead] = Reward;
+    ReplayDiscounts[ReplayHead] = Discount;
+    ReplayActions[ReplayHead] = Action;
+
+    ReplayHead = (ReplayHead + 1) % Config.ReplayCapacity;
+    ReplayNum = FMath::Min(ReplayNum + 1, Config.ReplayCapacity);
+
+    if (++TransitionsSinceTrain < Config.TrainEveryTransitions ||
+        ReplayNum < FMath::Max(Config.WarmupTransitions, Config.BatchSize))
+    {
+        return;
+    }
+    TransitionsSinceTrain = 0;
+
+    TrainStep();
+}
+
+void FHighLevelDQN::TrainStep()
+{
+    const int32 BatchSize = Config.BatchSize;
+
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        const int32 Index = Random.RandHelper(ReplayNum);
+        FMemory::Memcpy(&InputScratch[Sample * NumObservations], &ReplayObservations[Index * NumObservations],
+                        NumObservations * sizeof(float));
+        FMemory::Memcpy(&NextInputScratch[Sample * NumObservations], &ReplayNextObservations[Index * NumObservations],
+                        NumObservations * sizeof(float));
+        TargetScratch[Sample] = ReplayRewards[Index];
+        DiscountScratch[Sample] = ReplayDiscounts[Index];
+        ActionScratch[Sample] = ReplayActions[Index];
+    }
+
+    // TD-ціль рахує цільова мережа, яка оновлюється рідко - так ціль не тікає від онлайн-мережі
+    Target.Forward(NextInputScratch.GetData(), BatchSize, NextValueScratch.GetData());
+
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        TargetScratch[Sample] += DiscountScratch[Sample] * GetMaxOf(&NextValueScratch[Sample * NumActions]);
+    }
+
+    LastLoss = Online.TrainBatch(InputScratch.GetData(), ActionScratch.GetData(), TargetScratch.GetData(),
+                                 BatchSize, Config.LearningRate);
+    NumTrainSteps++;
+
+    if (NumTrainSteps % Config.TargetSyncSteps == 0)
+    {
+        Target.CopyWeightsFrom(Online);
+    }
+}
+
+bool FHighLevelDQN::SaveToFile(const FString& FullPath) const
+{
+    FString Directory = FPaths::GetPath(FullPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = DQNMagic;
+    int32 Version = DQNVersion;
+    int32 SavedInputs = Online.GetNumInputs();
+    int32 SavedHidden = Online.GetHiddenSize();
+    int32 SavedOutputs = Online.GetNumOutputs();
+    Writer << Magic << Version << SavedInputs << SavedHidden << SavedOutputs;
+
+    TArrayView<const float> Parameters = Online.GetParameters();
+    Writer.Serialize(const_cast<float*>(Parameters.GetData()), Parameters.Num() * sizeof(float));
+
+    return FFileHelper::SaveArrayToFile(Bytes, *FullPath);
+}
+
+bool FHighLevelDQN::LoadFromFile(const FString& FullPath)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FullPath))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 SavedInputs = 0;
+    int32 SavedHidden = 0;
+    int32 SavedOutputs = 0;
+    Reader << Magic << Version << SavedInputs << SavedHidden << SavedOutputs;
+
+    const int32 NumParameters = Online.GetParameters().Num();
+    if (Magic != DQNMagic || Version != DQNVersion || SavedInputs != Online.GetNumInputs() ||
+        SavedHidden != Online.GetHiddenSize() || SavedOutputs != Online.GetNumOutputs() ||
+        Bytes.Num() - Reader.Tell() != NumParameters * (int64)sizeof(float))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DQN weights in %s don't match the current network shape"), *FullPath);
+        return false;
+    }
+
+    TArray<float> Parameters;
+    Parameters.SetNumUninitialized(NumParameters);
+    Reader.Serialize(Parameters.GetData(), NumParameters * sizeof(float));
+
+    Online.SetParameters(Parameters);
+    Target.CopyWeightsFrom(Online);
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelValueBackend.h"
+#include "HighLevelMLP.h"
+
+struct FHighLevelDQNConfig
+{
+    int32 HiddenSize = 32;
+    float LearningRate = 0.001f;
+    int32 BatchSize = 32;
+    int32 ReplayCapacity = 20000;
+    int32 WarmupTransitions = 256;
+    int32 TrainEveryTransitions = 4;
+    // Кроки навчання між копіюваннями онлайн-мережі в цільову
+    int32 TargetSyncSteps = 250;
+    int32 Seed = 0;
+};
+
+// DQN: онлайн-мережа для рішень, цільова - для TD-цілей, власний кільцевий буфер спостережень.
+// Alpha з Learn не використовується - крок задає Adam з Config.LearningRate.
+class QLEARNING_API FHighLevelDQN : public FHighLevelValueBackend
+{
+public:
+    explicit FHighLevelDQN(const FHighLevelDQNConfig& InConfig = FHighLevelDQNConfig());
+
+    virtual void Evaluate(const float* Observation, float* OutValues) const override;
+    virtual void EvaluateBatch(const float* Observations, int32 Num, float* OutValues) const override;
+    virtual void Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                       const float* NextObservation, float Alpha) override;
+    virtual void Reset() override;
+
+    virtual FString GetFileName() const override { return TEXT("HighLevelDQN.bin"); }
+    virtual bool SaveToFile(const FString& FullPath) const override;
+    virtual bool LoadFromFile(const FString& FullPath) override;
+
+    const FHighLevelDQNConfig& GetConfig() const { return Config; }
+    int64 GetNumTrainSteps() const { return NumTrainSteps; }
+    float GetLastLoss() const { return LastLoss; }
+
+private:
+    // Потреби 0..100 -> 0..1, решта ознак уже нормована
+    static void Normalize(const float* Observation, float* OutInputs);
+    void TrainStep();
+
+    FHighLevelDQNConfig Config;
+    FHighLevelMLP Online;
+    FHighLevelMLP Target;
+    FRandomStream Random;
+
+    // Буфер повторів (SoA), спостереження вже нормовані
+    TArray<float> ReplayObservations;
+    TArray<float> ReplayNextObservations;
+    TArray<float> ReplayRewards;
+    TArray<float> ReplayDiscounts;
+    TArray<int32> ReplayActions;
+    int32 ReplayHead = 0;
+    int32 ReplayNum = 0;
+    int32 TransitionsSinceTrain = 0;
+
+    // Скретч одного кроку навчання і пакетного виводу
+    mutable TArray<float> InputScratch;
+    TArray<float> NextInputScratch;
+    TArray<float> NextValueScratch;
+    TArray<float> TargetScratch;
+    TArray<float> DiscountScratch;
+    TArray<int32> ActionScratch;
+
+    int64 NumTrainSteps = 0;
+    float LastLoss = 0.0f;
+};
@@ -0,0 +1,191 @@
+#include "HighLevelDynaModel.h"
+
+namespace
+{
+    // Черга обмежена, щоб після прогріву не було алокацій
+    constexpr int32 MaxQueueLength = FHighLevelDynaModel::NumSlots * 2;
+
+    struct FHigherPriority
+    {
+        template <typename T>
+        bool operator()(const T& A, const T& B) const { return A.Priority > B.Priority; }
+    };
+}
+
+FHighLevelDynaModel::FHighLevelDynaModel()
+{
+    Reset();
+}
+
+void FHighLevelDynaModel::Reset()
+{
+    Pairs.Reset();
+    Pairs.SetNum(NumSlots);
+    PredecessorHead.Init(INDEX_NONE, FHighLevelQTable::NumStates);
+    PredecessorNext.Init(INDEX_NONE, NumSlots * MaxOutcomes);
+    PredecessorPrev.Init(INDEX_NONE, NumSlots * MaxOutcomes);
+    QueuedPriority.Init(0.0f, NumSlots);
+    Queue.Reset(MaxQueueLength);
+    NumKnownPairs = 0;
+}
+
+void FHighLevelDynaModel::Observe(const FHighLevelQTable& Table, int32 State, int32 Action, float Reward,
+                                  int32 NextState, float Discount, float Threshold)
+{
+    const int32 Slot = State * FHighLevelQTable::NumActions + Action;
+    FPairModel& Pair = Pairs[Slot];
+
+    if (Pair.Count == 0)
+    {
+        NumKnownPairs++;
+    }
+    Pair.Count++;
+    Pair.MeanReward += (Reward - Pair.MeanReward) / Pair.Count;
+    Pair.MeanDiscount += (Discount - Pair.MeanDiscount) / Pair.Count;
+
+    // Той самий наступний стан, вільна комірка або найрідкісніший результат
+    FOutcome* Target = nullptr;
+    for (FOutcome& Outcome : Pair.Outcomes)
+    {
+        if (Outcome.NextState == NextState)
+        {
+            Target = &Outcome;
+            break;
+        }
+        if (!Target || Outcome.Count < Target->Count)
+        {
+            Target = &Outcome;
+        }
+    }
+
+    if (Target->NextState != NextState)
+    {
+        // Витіснений результат більше не веде в старий стан
+        const int32 OutcomeIndex = Slot * MaxOutcomes + (int32)(Target - Pair.Outcomes);
+        if (Target->NextState != INDEX_NONE)
+        {
+            UnlinkPredecessor(OutcomeIndex, Target->NextState);
+        }
+        LinkPredecessor(OutcomeIndex, NextState);
+
+        Target->NextState = NextState;
+        Target->Count = 0;
+    }
+    Target->Count++;
+
+    const float Priority = FMath::Abs(ComputeTarget(Table, Slot) - Table.GetValue(State, Action));
+    if (Priority > Threshold)
+    {
+        Push(Slot, Priority);
+    }
+}
+
+void FHighLevelDynaModel::LinkPredecessor(int32 OutcomeIndex, int32 NextState)
+{
+    const int32 Head = PredecessorHead[NextState];
+    PredecessorPrev[OutcomeIndex] = INDEX_NONE;
+    PredecessorNext[OutcomeIndex] = Head;
+    if (Head != INDEX_NONE)
+    {
+        PredecessorPrev[Head] = OutcomeIndex;
+    }
+    PredecessorHead[NextState] = OutcomeIndex;
+}
+
+void FHighLevelDynaModel::UnlinkPredecessor(int32 OutcomeIndex, int32 NextState)
+{
+    const int32 Prev = PredecessorPrev[OutcomeIndex];
+    const int32 Next = PredecessorNext[OutcomeIndex];
+    if (Prev != INDEX_NONE)
+    {
+        PredecessorNext[Prev] = Next;
+    }
+    else
+    {
+        PredecessorHead[NextState] = Next;
+    }
+    if (Next != INDEX_NONE)
+    {
+        PredecessorPrev[Next] = Prev;
+    }
+    PredecessorPrev[OutcomeIndex] = INDEX_NONE;
+    PredecessorNext[OutcomeIndex] = INDEX_NONE;
+}
+
+float FHighLevelDynaModel::ComputeTarget(const FHighLevelQTable& Table, int32 Slot) const
+{
+    const FPairModel& Pair = Pairs[Slot];
+
+    int32 TotalCount = 0;
+    float ExpectedNext = 0.0f;
+    for (const FOutcome& Outcome : Pair.Outcomes)
+    {
+        if (Outcome.NextState != INDEX_NONE)
+        {
+            TotalCount += Outcome.Count;
+            ExpectedNext += Outcome.Count * Table.GetMaxValue(Outcome.NextState);
+        }
+    }
+
+    return Pair.MeanReward + (TotalCount > 0 ? Pair.MeanDiscount * ExpectedNext / TotalCount : 0.0f);
+}
+
+void FHighLevelDynaModel::Push(int32 Slot, float Priority)
+{
+    if (Priority <= QueuedPriority[Slot] || Queue.Num() >= MaxQueueLength)
+    {
+        return;
+    }
+
+    QueuedPriority[Slot] = Priority;
+    Queue.HeapPush(FQueueEntry{ Priority, Slot }, FHigherPriority());
+}
+
+bool FHighLevelDynaModel::Pop(int32& OutSlot)
+{
+    while (Queue.Num() > 0)
+    {
+        FQueueEntry Entry;
+        Queue.HeapPop(Entry, FHigherPriority(), EAllowShrinking::No);
+
+        // Застарілий дублікат - пару вже оновлено з вищим пріоритетом
+        if (QueuedPriority[Entry.Slot] > 0.0f)
+        {
+            QueuedPriority[Entry.Slot] = 0.0f;
+            OutSlot = Entry.Slot;
+            return true;
+        }
+    }
+    return false;
+}
+
+int32 FHighLevelDynaModel::PlanSteps(FHighLevelQTable& Table, int32 MaxSteps, float Alpha, float Threshold)
+{
+    int32 Steps = 0;
+    int32 Slot = 0;
+
+    while (Steps < MaxSteps && Pop(Slot))
+    {
+        const int32 State = Slot / FHighLevelQTable::NumActions;
+        const int32 Action = Slot % FHighLevelQTable::NumActions;
+
+        const float Q = Table.GetValue(State, Action);
+        Table.SetValueNoVisit(State, Action, Q + Alpha * (ComputeTarget(Table, Slot) - Q));
+        Steps++;
+
+        // Значення стану змінилось - перевіряємо пари, що ведуть у нього
+        for (int32 Node = PredecessorHead[State]; Node != INDEX_NONE; Node = PredecessorNext[Node])
+        {
+            const int32 PredSlot = Node / MaxOutcomes;
+            const int32 PredState = PredSlot / FHighLevelQTable::NumActions;
+            const int32 PredAction = PredSlot % FHighLevelQTable::NumActions;
+            const float Priority = FMath::Abs(ComputeTarget(Table, PredSlot) - Table.GetValue(PredState, PredAction));
+            if (Priority > Threshold)
+            {
+                Push(PredSlot, Priority);
+            }
+        }
+    }
+
+    return Steps;
+}
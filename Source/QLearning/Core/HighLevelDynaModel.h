@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+
+// Таблична модель середовища для Dyna-Q: для кожної пари (стан, макро-дія) середні нагорода і дисконт
+// і до MaxOutcomes наступних станів з частотами. Планування - пріоритетне прочісування (prioritized sweeping).
+struct QLEARNING_API FHighLevelDynaModel
+{
+    static constexpr int32 NumSlots = FHighLevelQTable::NumStates * FHighLevelQTable::NumActions;
+    static constexpr int32 MaxOutcomes = 4;
+
+    FHighLevelDynaModel();
+
+    void Reset();
+
+    // Записує перехід і ставить пару в чергу, якщо TD-похибка більша за поріг
+    void Observe(const FHighLevelQTable& Table, int32 State, int32 Action, float Reward, int32 NextState,
+                 float Discount, float Threshold);
+
+    // До MaxSteps оновлень з найбільшим пріоритетом; повертає скільки зроблено
+    int32 PlanSteps(FHighLevelQTable& Table, int32 MaxSteps, float Alpha, float Threshold);
+
+    int32 GetNumQueued() const { return Queue.Num(); }
+    int32 GetNumKnownPairs() const { return NumKnownPairs; }
+
+private:
+    struct FOutcome
+    {
+        int32 NextState = INDEX_NONE;
+        int32 Count = 0;
+    };
+
+    struct FPairModel
+    {
+        float MeanReward = 0.0f;
+        // У режимі SMDP γ залежить від тривалості, тож модель пам'ятає середній
+        float MeanDiscount = 0.0f;
+        int32 Count = 0;
+        FOutcome Outcomes[MaxOutcomes];
+    };
+
+    struct FQueueEntry
+    {
+        float Priority = 0.0f;
+        int32 Slot = 0;
+    };
+
+    float ComputeTarget(const FHighLevelQTable& Table, int32 Slot) const;
+    void Push(int32 Slot, float Priority);
+    bool Pop(int32& OutSlot);
+    void LinkPredecessor(int32 OutcomeIndex, int32 NextState);
+    void UnlinkPredecessor(int32 OutcomeIndex, int32 NextState);
+
+    TArray<FPairModel> Pairs;
+
+    // Для кожного стану - двозв'язний список результатів (Slot * MaxOutcomes + k), що в нього ведуть.
+    // Вузли виділені наперед на всі результати, тож витіснення результату просто переносить вузол
+    TArray<int32> PredecessorHead;
+    TArray<int32> PredecessorNext;
+    TArray<int32> PredecessorPrev;
+
+    // Макс-купа; дублікати дозволені, QueuedPriority відсікає вже оброблені
+    TArray<FQueueEntry> Queue;
+    TArray<float> QueuedPriority;
+    int32 NumKnownPairs = 0;
+};
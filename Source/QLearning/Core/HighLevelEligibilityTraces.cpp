@@ -0,0 +1,58 @@
+#include "HighLevelEligibilityTraces.h"
+
+void FHighLevelEligibilityTraces::Decay(float Factor)
+{
+    // Окремий прохід множення без розгалужень - компілятор векторизує його
+    for (int32 i = 0; i < NumTraces; i++)
+    {
+        Traces[i] *= Factor;
+    }
+
+    int32 Kept = 0;
+    for (int32 i = 0; i < NumTraces; i++)
+    {
+        if (Traces[i] >= MinTrace)
+        {
+            Traces[Kept] = Traces[i];
+            Slots[Kept] = Slots[i];
+            Kept++;
+        }
+    }
+    NumTraces = Kept;
+}
+
+void FHighLevelEligibilityTraces::Replace(int32 Slot)
+{
+    int32 Smallest = 0;
+    for (int32 i = 0; i < NumTraces; i++)
+    {
+        if (Slots[i] == Slot)
+        {
+            Traces[i] = 1.0f;
+            return;
+        }
+        if (Traces[i] < Traces[Smallest])
+        {
+            Smallest = i;
+        }
+    }
+
+    const int32 Index = NumTraces < MaxTraces ? NumTraces++ : Smallest;
+    Slots[Index] = Slot;
+    Traces[Index] = 1.0f;
+}
+
+void FHighLevelEligibilityTraces::Apply(FHighLevelQTable& Table, float Alpha, float Delta, int32 SkipSlot) const
+{
+    const float Step = Alpha * Delta;
+    for (int32 i = 0; i < NumTraces; i++)
+    {
+        const int32 Slot = Slots[i];
+        if (Slot != SkipSlot)
+        {
+            const int32 State = Slot / FHighLevelQTable::NumActions;
+            const int32 Action = Slot % FHighLevelQTable::NumActions;
+            Table.SetValueNoVisit(State, Action, Table.GetValue(State, Action) + Step * Traces[i]);
+        }
+    }
+}
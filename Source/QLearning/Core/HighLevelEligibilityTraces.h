@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+
+// Розріджені сліди допустимості для Watkins Q(λ): фіксований масив пар (слот таблиці, слід) у SoA-вигляді.
+// Оновлення торкається тільки рядків зі слідом, без проходу по всій таблиці.
+struct QLEARNING_API FHighLevelEligibilityTraces
+{
+    static constexpr int32 MaxTraces = 32;
+    static constexpr float MinTrace = 0.01f;
+
+    void Reset() { NumTraces = 0; }
+    int32 Num() const { return NumTraces; }
+
+    // Множить усі сліди на Decay і викидає ті, що впали нижче MinTrace
+    void Decay(float Factor);
+
+    // Замінний слід: пара отримує 1; якщо місця немає - витісняється найменший
+    void Replace(int32 Slot);
+
+    // Q += Alpha * Delta * e для всіх пар, крім SkipSlot (його оновлює викликач із лічильником візитів)
+    void Apply(FHighLevelQTable& Table, float Alpha, float Delta, int32 SkipSlot) const;
+
+private:
+    alignas(16) float Traces[MaxTraces];
+    int32 Slots[MaxTraces];
+    int32 NumTraces = 0;
+};
@@ -0,0 +1,118 @@
+#include "HighLevelExploration.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    int32 GetArgMax(const float* Values)
+    {
+        int32 BestAction = 0;
+        for (int32 i = 1; i < FHighLevelExploration::NumActions; i++)
+        {
+            if (Values[i] > Values[BestAction])
+            {
+                BestAction = i;
+            }
+        }
+        return BestAction;
+    }
+
+    constexpr int32 NumPaddedActions = (FHighLevelExploration::NumActions + 3) & ~3;
+}
+
+int32 FEpsilonGreedyExploration::ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const
+{
+    if (Random.FRand() < GetScheduleValue(Progress))
+    {
+        return Random.RandHelper(NumActions);
+    }
+    return GreedyAction != INDEX_NONE ? GreedyAction : GetArgMax(Values);
+}
+
+int32 FUCB1Exploration::ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const
+{
+    int32 TotalCount = 0;
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        // Спершу кожна дія хоча б раз - випадкова серед невипробуваних
+        if (Counts[i] == 0)
+        {
+            int32 Untried[NumActions];
+            int32 NumUntried = 0;
+            for (int32 j = i; j < NumActions; j++)
+            {
+                if (Counts[j] == 0)
+                {
+                    Untried[NumUntried++] = j;
+                }
+            }
+            return Untried[Random.RandHelper(NumUntried)];
+        }
+        TotalCount += Counts[i];
+    }
+
+    const float LogTotal = FMath::Loge((float)TotalCount);
+    float Scores[NumActions];
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        Scores[i] = Values[i] + Scale * FMath::Sqrt(LogTotal / Counts[i]);
+    }
+    return GetArgMax(Scores);
+}
+
+VectorRegister4Float FBoltzmannExploration::VectorExpNonPositive(VectorRegister4Float X)
+{
+    // Нижче -1024 основа стала б від'ємною, а e^-1024 і так нуль
+    X = VectorMax(X, VectorSetFloat1(-1024.0f));
+    VectorRegister4Float Result = VectorMultiplyAdd(X, VectorSetFloat1(1.0f / 1024.0f), VectorSetFloat1(1.0f));
+    for (int32 i = 0; i < 10; i++)
+    {
+        Result = VectorMultiply(Result, Result);
+    }
+    return Result;
+}
+
+int32 FBoltzmannExploration::ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const
+{
+    const float Temperature = FMath::Max(GetScheduleValue(Progress), KINDA_SMALL_NUMBER);
+    const float MaxValue = Values[GetArgMax(Values)];
+
+    // Віднімаємо максимум - усі показники <= 0, переповнення немає; зайві лінії дають нуль
+    alignas(16) float Exponents[NumPaddedActions];
+    for (int32 i = 0; i < NumPaddedActions; i++)
+    {
+        Exponents[i] = i < NumActions ? (Values[i] - MaxValue) / Temperature : -1024.0f;
+    }
+
+    alignas(16) float Weights[NumPaddedActions];
+    for (int32 i = 0; i < NumPaddedActions; i += 4)
+    {
+        VectorStoreAligned(VectorExpNonPositive(VectorLoadAligned(&Exponents[i])), &Weights[i]);
+    }
+
+    float TotalWeight = 0.0f;
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        TotalWeight += Weights[i];
+    }
+
+    float Pick = Random.FRand() * TotalWeight;
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        Pick -= Weights[i];
+        if (Pick < 0.0f)
+        {
+            return i;
+        }
+    }
+    return GetArgMax(Values);
+}
+
+int32 FCountBonusExploration::ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const
+{
+    float Scores[NumActions];
+    for (int32 i = 0; i < NumActions; i++)
+    {
+        Scores[i] = Values[i] + Scale * FMath::InvSqrt((float)Counts[i] + 1.0f);
+    }
+    return GetArgMax(Scores);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+
+// Стратегія вибору макро-дії з Q-значень і лічильників оновлень одного стану.
+// Progress - кількість оновлень таблиці (спільна для всіх NPC і поколінь, стартує з GetTotalUpdates
+// завантаженої таблиці), тож графік не починається спочатку з кожним новим NPC.
+// FHouseholdBatchSimulator рахує той самий прогрес - NumEnvironments оновлень за крок.
+class QLEARNING_API FHighLevelExploration
+{
+public:
+    static constexpr int32 NumActions = FHighLevelQTable::NumActions;
+
+    virtual ~FHighLevelExploration() = default;
+
+    // Values і Counts - по NumActions; Counts - nullptr, якщо лічильників немає (апроксиматори).
+    // GreedyAction - кешований argmax таблиці або INDEX_NONE; Values - nullptr, якщо NeedsValues() == false.
+    virtual int32 ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const = 0;
+
+    // Стратегіям без лічильників викликач підставляє epsilon-greedy
+    virtual bool NeedsCounts() const { return false; }
+
+    // false - стратегії досить жадібної дії, рядок Q можна не копіювати
+    virtual bool NeedsValues() const { return true; }
+
+    // Поточна "температура" графіка для логів: epsilon або T
+    virtual float GetScheduleValue(int64 Progress) const { return 0.0f; }
+
+    static float GetDecayedValue(float Start, float Min, float Decay, int64 Progress)
+    {
+        return FMath::Max(Min, Start * FMath::Pow(Decay, (float)Progress));
+    }
+};
+
+class QLEARNING_API FEpsilonGreedyExploration : public FHighLevelExploration
+{
+public:
+    FEpsilonGreedyExploration(float InStartRate, float InMinRate, float InDecay)
+        : StartRate(InStartRate), MinRate(InMinRate), Decay(InDecay) {}
+
+    virtual int32 ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const override;
+    virtual bool NeedsValues() const override { return false; }
+    virtual float GetScheduleValue(int64 Progress) const override { return GetDecayedValue(StartRate, MinRate, Decay, Progress); }
+
+private:
+    float StartRate;
+    float MinRate;
+    float Decay;
+};
+
+// UCB1: Q + Scale * sqrt(ln N / n); невипробувані дії - першими
+class QLEARNING_API FUCB1Exploration : public FHighLevelExploration
+{
+public:
+    explicit FUCB1Exploration(float InScale) : Scale(InScale) {}
+
+    virtual int32 ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const override;
+    virtual bool NeedsCounts() const override { return true; }
+
+private:
+    float Scale;
+};
+
+// Softmax по Q / T; T спадає від StartTemperature до MinTemperature за глобальним графіком
+class QLEARNING_API FBoltzmannExploration : public FHighLevelExploration
+{
+public:
+    FBoltzmannExploration(float InStartTemperature, float InMinTemperature, float InDecay)
+        : StartTemperature(InStartTemperature), MinTemperature(InMinTemperature), Decay(InDecay) {}
+
+    virtual int32 ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const override;
+    virtual float GetScheduleValue(int64 Progress) const override { return GetDecayedValue(StartTemperature, MinTemperature, Decay, Progress); }
+
+    // exp(x) для x <= 0 на чотирьох лініях: (1 + x / 1024)^1024 - тільки множення, без таблиць
+    static VectorRegister4Float VectorExpNonPositive(VectorRegister4Float X);
+
+private:
+    float StartTemperature;
+    float MinTemperature;
+    float Decay;
+};
+
+// Жадібно по Q + Scale / sqrt(n + 1): бонус за рідко випробувані дії
+class QLEARNING_API FCountBonusExploration : public FHighLevelExploration
+{
+public:
+    explicit FCountBonusExploration(float InScale) : Scale(InScale) {}
+
+    virtual int32 ChooseAction(const float* Values, const int32* Counts, int32 GreedyAction, int64 Progress, FRandomStream& Random) const override;
+    virtual bool NeedsCounts() const override { return true; }
+
+private:
+    float Scale;
+};
@@ -0,0 +1,273 @@
+#include "HighLevelMLP.h"
+
+namespace
+{
+    constexpr float AdamBeta1 = 0.9f;
+    constexpr float AdamBeta2 = 0.999f;
+    constexpr float AdamEpsilon = 1e-8f;
+
+    float HorizontalSum(VectorRegister4Float Value)
+    {
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(Value, Lanes);
+        return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+    }
+}
+
+void FHighLevelMLP::Init(int32 InNumInputs, int32 InHiddenSize, int32 InNumOutputs, int32 Seed)
+{
+    NumInputs = InNumInputs;
+    HiddenSize = Align(FMath::Max(InHiddenSize, 4), 4);
+    NumOutputs = InNumOutputs;
+
+    const int32 Widths[NumLayers + 1] = { Align(NumInputs, 4), HiddenSize, HiddenSize, Align(NumOutputs, 4) };
+
+    int32 Offset = 0;
+    for (int32 Index = 0; Index < NumLayers; Index++)
+    {
+        FLayer& Layer = Layers[Index];
+        Layer.NumIn = Widths[Index];
+        Layer.NumOut = Widths[Index + 1];
+        Layer.WeightOffset = Offset;
+        Offset += Layer.NumIn * Layer.NumOut;
+        Layer.BiasOffset = Offset;
+        Offset += Layer.NumOut;
+    }
+
+    Parameters.Init(0.0f, Offset);
+    Gradients.Init(0.0f, Offset);
+    AdamM.Init(0.0f, Offset);
+    AdamV.Init(0.0f, Offset);
+    AdamStep = 0;
+
+    // He-uniform для справжніх входів і виходів; вирівнювання лишається нулями і ніколи не вчиться
+    FRandomStream Random(Seed);
+    for (int32 Index = 0; Index < NumLayers; Index++)
+    {
+        const FLayer& Layer = Layers[Index];
+        const int32 RealIn = Index == 0 ? NumInputs : Layer.NumIn;
+        const int32 RealOut = Index == NumLayers - 1 ? NumOutputs : Layer.NumOut;
+        const float Limit = FMath::Sqrt(6.0f / RealIn);
+
+        for (int32 In = 0; In < RealIn; In++)
+        {
+            for (int32 Out = 0; Out < RealOut; Out++)
+            {
+                Parameters[Layer.WeightOffset + In * Layer.NumOut + Out] = Random.FRandRange(-Limit, Limit);
+            }
+        }
+    }
+}
+
+bool FHighLevelMLP::SetParameters(TArrayView<const float> InParameters)
+{
+    if (InParameters.Num() != Parameters.Num())
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(Parameters.GetData(), InParameters.GetData(), Parameters.Num() * sizeof(float));
+    FMemory::Memzero(AdamM.GetData(), AdamM.Num() * sizeof(float));
+    FMemory::Memzero(AdamV.GetData(), AdamV.Num() * sizeof(float));
+    AdamStep = 0;
+    return true;
+}
+
+void FHighLevelMLP::CopyWeightsFrom(const FHighLevelMLP& Other)
+{
+    check(Other.Parameters.Num() == Parameters.Num());
+    FMemory::Memcpy(Parameters.GetData(), Other.Parameters.GetData(), Parameters.Num() * sizeof(float));
+}
+
+void FHighLevelMLP::ForwardLayer(const FLayer& Layer, const float* In, float* Out, int32 BatchSize, bool bReLU) const
+{
+    const float* Weights = Parameters.GetData() + Layer.WeightOffset;
+    const float* Biases = Parameters.GetData() + Layer.BiasOffset;
+
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        FMemory::Memcpy(Out + Sample * Layer.NumOut, Biases, Layer.NumOut * sizeof(float));
+    }
+
+    // Рядок ваг входу лишається в кеші, поки по ньому проходять усі зразки пакета
+    for (int32 Input = 0; Input < Layer.NumIn; Input++)
+    {
+        const float* Row = Weights + Input * Layer.NumOut;
+
+        for (int32 Sample = 0; Sample < BatchSize; Sample++)
+        {
+            const float X = In[Sample * Layer.NumIn + Input];
+            if (X == 0.0f)
+            {
+                continue;
+            }
+
+            const VectorRegister4Float XV = VectorSetFloat1(X);
+            float* OutRow = Out + Sample * Layer.NumOut;
+            for (int32 Col = 0; Col < Layer.NumOut; Col += 4)
+            {
+                VectorStoreAligned(VectorMultiplyAdd(XV, VectorLoadAligned(Row + Col), VectorLoadAligned(OutRow + Col)), OutRow + Col);
+            }
+        }
+    }
+
+    if (bReLU)
+    {
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        for (int32 Index = 0; Index < BatchSize * Layer.NumOut; Index += 4)
+        {
+            VectorStoreAligned(VectorMax(VectorLoadAligned(Out + Index), Zero), Out + Index);
+        }
+    }
+}
+
+void FHighLevelMLP::ForwardLayers(const float* Inputs, int32 BatchSize) const
+{
+    const int32 PaddedInputs = Layers[0].NumIn;
+    Activations[0].SetNumUninitialized(BatchSize * PaddedInputs, EAllowShrinking::No);
+
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        float* Row = Activations[0].GetData() + Sample * PaddedInputs;
+        FMemory::Memcpy(Row, Inputs + Sample * NumInputs, NumInputs * sizeof(float));
+        FMemory::Memzero(Row + NumInputs, (PaddedInputs - NumInputs) * sizeof(float));
+    }
+
+    for (int32 Index = 0; Index < NumLayers; Index++)
+    {
+        const FLayer& Layer = Layers[Index];
+        Activations[Index + 1].SetNumUninitialized(BatchSize * Layer.NumOut, EAllowShrinking::No);
+        ForwardLayer(Layer, Activations[Index].GetData(), Activations[Index + 1].GetData(), BatchSize, Index < NumLayers - 1);
+    }
+}
+
+void FHighLevelMLP::Forward(const float* Inputs, int32 BatchSize, float* OutValues) const
+{
+    ForwardLayers(Inputs, BatchSize);
+
+    const int32 PaddedOutputs = Layers[NumLayers - 1].NumOut;
+    const float* Output = Activations[NumLayers].GetData();
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        FMemory::Memcpy(OutValues + Sample * NumOutputs, Output + Sample * PaddedOutputs, NumOutputs * sizeof(float));
+    }
+}
+
+void FHighLevelMLP::BackwardLayer(const FLayer& Layer, const float* In, const float* OutGrad, float* InGrad, int32 BatchSize)
+{
+    const float* Weights = Parameters.GetData() + Layer.WeightOffset;
+    float* WeightGrad = Gradients.GetData() + Layer.WeightOffset;
+    float* BiasGrad = Gradients.GetData() + Layer.BiasOffset;
+
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        const float* G = OutGrad + Sample * Layer.NumOut;
+        for (int32 Col = 0; Col < Layer.NumOut; Col += 4)
+        {
+            VectorStoreAligned(VectorAdd(VectorLoadAligned(BiasGrad + Col), VectorLoadAligned(G + Col)), BiasGrad + Col);
+        }
+    }
+
+    for (int32 Input = 0; Input < Layer.NumIn; Input++)
+    {
+        const float* Row = Weights + Input * Layer.NumOut;
+        float* GradRow = WeightGrad + Input * Layer.NumOut;
+
+        for (int32 Sample = 0; Sample < BatchSize; Sample++)
+        {
+            const float* G = OutGrad + Sample * Layer.NumOut;
+            const float X = In[Sample * Layer.NumIn + Input];
+
+            // dW += x * dOut
+            if (X != 0.0f)
+            {
+                const VectorRegister4Float XV = VectorSetFloat1(X);
+                for (int32 Col = 0; Col < Layer.NumOut; Col += 4)
+                {
+                    VectorStoreAligned(VectorMultiplyAdd(XV, VectorLoadAligned(G + Col), VectorLoadAligned(GradRow + Col)), GradRow + Col);
+                }
+            }
+
+            // dIn = W * dOut
+            if (InGrad)
+            {
+                VectorRegister4Float Sum = VectorZeroFloat();
+                for (int32 Col = 0; Col < Layer.NumOut; Col += 4)
+                {
+                    Sum = VectorMultiplyAdd(VectorLoadAligned(Row + Col), VectorLoadAligned(G + Col), Sum);
+                }
+                InGrad[Sample * Layer.NumIn + Input] = HorizontalSum(Sum);
+            }
+        }
+    }
+}
+
+float FHighLevelMLP::TrainBatch(const float* Inputs, const int32* Outputs, const float* Targets, int32 BatchSize, float LearningRate)
+{
+    if (BatchSize <= 0)
+    {
+        return 0.0f;
+    }
+
+    ForwardLayers(Inputs, BatchSize);
+
+    const FLayer& Last = Layers[NumLayers - 1];
+    // Буфер живе між викликами - градієнти попереднього мінібатчу мають зникнути повністю
+    LayerGradients[NumLayers].SetNumUninitialized(BatchSize * Last.NumOut, EAllowShrinking::No);
+    FMemory::Memzero(LayerGradients[NumLayers].GetData(), LayerGradients[NumLayers].Num() * sizeof(float));
+
+    float Loss = 0.0f;
+    for (int32 Sample = 0; Sample < BatchSize; Sample++)
+    {
+        const int32 Index = Sample * Last.NumOut + Outputs[Sample];
+        const float Error = Activations[NumLayers][Index] - Targets[Sample];
+        const float AbsError = FMath::Abs(Error);
+
+        Loss += AbsError <= 1.0f ? 0.5f * Error * Error : AbsError - 0.5f;
+        LayerGradients[NumLayers][Index] = FMath::Clamp(Error, -1.0f, 1.0f) / BatchSize;
+    }
+
+    FMemory::Memzero(Gradients.GetData(), Gradients.Num() * sizeof(float));
+
+    for (int32 Index = NumLayers - 1; Index >= 0; Index--)
+    {
+        const FLayer& Layer = Layers[Index];
+        float* InGrad = nullptr;
+        if (Index > 0)
+        {
+            LayerGradients[Index].SetNumUninitialized(BatchSize * Layer.NumIn, EAllowShrinking::No);
+            InGrad = LayerGradients[Index].GetData();
+        }
+
+        BackwardLayer(Layer, Activations[Index].GetData(), LayerGradients[Index + 1].GetData(), InGrad, BatchSize);
+
+        // Похідна ReLU: градієнт проходить тільки через активні нейрони
+        if (InGrad)
+        {
+            const float* Activation = Activations[Index].GetData();
+            for (int32 Element = 0; Element < BatchSize * Layer.NumIn; Element++)
+            {
+                InGrad[Element] = Activation[Element] > 0.0f ? InGrad[Element] : 0.0f;
+            }
+        }
+    }
+
+    // Adam з корекцією зсуву, зведеною в розмір кроку
+    AdamStep++;
+    const float Correction1 = 1.0f - FMath::Pow(AdamBeta1, (float)AdamStep);
+    const float Correction2 = 1.0f - FMath::Pow(AdamBeta2, (float)AdamStep);
+    const float StepSize = LearningRate * FMath::Sqrt(Correction2) / Correction1;
+
+    float* RESTRICT Params = Parameters.GetData();
+    float* RESTRICT M = AdamM.GetData();
+    float* RESTRICT V = AdamV.GetData();
+    const float* RESTRICT G = Gradients.GetData();
+    for (int32 Index = 0; Index < Parameters.Num(); Index++)
+    {
+        M[Index] = AdamBeta1 * M[Index] + (1.0f - AdamBeta1) * G[Index];
+        V[Index] = AdamBeta2 * V[Index] + (1.0f - AdamBeta2) * G[Index] * G[Index];
+        Params[Index] -= StepSize * M[Index] / (FMath::Sqrt(V[Index]) + AdamEpsilon);
+    }
+
+    return Loss / BatchSize;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Невеликий перцептрон з ReLU на CPU: Inputs -> Hidden -> Hidden -> Outputs.
+// Ширини шарів вирівняні до 4; ваги шару зберігаються рядком на вхід (NumIn x NumOut),
+// тож прямий і зворотний проходи - множення-додавання цілих рядків векторними регістрами.
+// Пакетний прохід читає кожен рядок ваг один раз на весь пакет.
+// Не потокобезпечний: скретч-буфери спільні для всіх викликів.
+class QLEARNING_API FHighLevelMLP
+{
+public:
+    void Init(int32 InNumInputs, int32 InHiddenSize, int32 InNumOutputs, int32 Seed);
+
+    // Inputs - BatchSize x NumInputs, OutValues - BatchSize x NumOutputs (без вирівнювання)
+    void Forward(const float* Inputs, int32 BatchSize, float* OutValues) const;
+
+    // Huber-втрата тільки для виходу Outputs[b] = Targets[b], один крок Adam; повертає середню втрату
+    float TrainBatch(const float* Inputs, const int32* Outputs, const float* Targets, int32 BatchSize, float LearningRate);
+
+    void CopyWeightsFrom(const FHighLevelMLP& Other);
+
+    int32 GetNumInputs() const { return NumInputs; }
+    int32 GetHiddenSize() const { return HiddenSize; }
+    int32 GetNumOutputs() const { return NumOutputs; }
+
+    // Плоский масив ваг і зсувів для збереження
+    TArrayView<const float> GetParameters() const { return Parameters; }
+
+    // Градієнти останнього TrainBatch до кроку Adam (для перевірок)
+    TArrayView<const float> GetGradients() const { return Gradients; }
+    bool SetParameters(TArrayView<const float> InParameters);
+
+private:
+    static constexpr int32 NumLayers = 3;
+
+    struct FLayer
+    {
+        int32 NumIn = 0;
+        int32 NumOut = 0;
+        int32 WeightOffset = 0;
+        int32 BiasOffset = 0;
+    };
+
+    void ForwardLayers(const float* Inputs, int32 BatchSize) const;
+    void ForwardLayer(const FLayer& Layer, const float* In, float* Out, int32 BatchSize, bool bReLU) const;
+    void BackwardLayer(const FLayer& Layer, const float* In, const float* OutGrad, float* InGrad, int32 BatchSize);
+
+    int32 NumInputs = 0;
+    int32 HiddenSize = 0;
+    int32 NumOutputs = 0;
+    FLayer Layers[NumLayers];
+
+    TArray<float, TAlignedHeapAllocator<16>> Parameters;
+    TArray<float, TAlignedHeapAllocator<16>> Gradients;
+    TArray<float, TAlignedHeapAllocator<16>> AdamM;
+    TArray<float, TAlignedHeapAllocator<16>> AdamV;
+    int32 AdamStep = 0;
+
+    // Активації шарів для пакета: [0] - вирівняний вхід, [NumLayers] - вихід
+    mutable TArray<float, TAlignedHeapAllocator<16>> Activations[NumLayers + 1];
+    TArray<float, TAlignedHeapAllocator<16>> LayerGradients[NumLayers + 1];
+};
@@ -0,0 +1,39 @@
+#include "HighLevelPublishedPolicy.h"
+
+FHighLevelPublishedPolicy::FReadScope::FReadScope(const FHighLevelPublishedPolicy& InOwner)
+    : Owner(InOwner)
+{
+    // Якщо буфер встиг стати заднім між читанням індексу і позначкою - пробуємо ще раз
+    for (;;)
+    {
+        Index = Owner.FrontIndex.load();
+        Owner.NumReaders[Index].fetch_add(1);
+        if (Owner.FrontIndex.load() == Index)
+        {
+            break;
+        }
+        Owner.NumReaders[Index].fetch_sub(1);
+    }
+}
+
+FHighLevelPublishedPolicy::FReadScope::~FReadScope()
+{
+    Owner.NumReaders[Index].fetch_sub(1);
+}
+
+void FHighLevelPublishedPolicy::Publish(const FHighLevelQTable& Source)
+{
+    const int32 BackIndex = 1 - FrontIndex.load();
+
+    // Читання - одне рішення NPC, тож чекати доводиться мікросекунди
+    while (NumReaders[BackIndex].load() != 0)
+    {
+        FPlatformProcess::Yield();
+    }
+
+    Buffers[BackIndex] = Source;
+    Buffers[BackIndex].RefreshDirtyRows();
+
+    FrontIndex.store(BackIndex);
+    NumPublished++;
+}
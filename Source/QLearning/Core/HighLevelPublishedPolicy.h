@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+#include <atomic>
+
+// Подвійний буфер копій високорівневої таблиці: один потік публікує, ігровий потік читає без замків.
+// Читач позначає свій буфер лічильником, писач чекає, поки задній буфер звільниться.
+class QLEARNING_API FHighLevelPublishedPolicy
+{
+public:
+    class FReadScope
+    {
+    public:
+        explicit FReadScope(const FHighLevelPublishedPolicy& InOwner);
+        ~FReadScope();
+
+        FReadScope(const FReadScope&) = delete;
+        FReadScope& operator=(const FReadScope&) = delete;
+
+        const FHighLevelQTable& GetTable() const { return Owner.Buffers[Index]; }
+
+    private:
+        const FHighLevelPublishedPolicy& Owner;
+        int32 Index = 0;
+    };
+
+    // Копіює Source у задній буфер і робить його переднім; кеш рядків копії перераховано заздалегідь
+    void Publish(const FHighLevelQTable& Source);
+
+    int64 GetNumPublished() const { return NumPublished.load(); }
+
+private:
+    FHighLevelQTable Buffers[2];
+    std::atomic<int32> FrontIndex{0};
+    mutable std::atomic<int32> NumReaders[2] = {{0}, {0}};
+    std::atomic<int64> NumPublished{0};
+};
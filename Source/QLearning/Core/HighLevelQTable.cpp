@@ -0,0 +1,305 @@
+#include "HighLevelQTable.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "Json.h"
+
+namespace
+{
+    constexpr uint32 TableBytesMagic = 0x54484C51; // "QLHT"
+    constexpr int32 TableBytesVersion = 1;
+
+    struct FTableBytesHeader
+    {
+        uint32 Magic;
+        int32 Version;
+        int32 NumStates;
+        int32 NumActions;
+    };
+}
+
+FHighLevelQTable::FHighLevelQTable()
+{
+    Reset();
+}
+
+void FHighLevelQTable::Reset()
+{
+    Values.Init(0.0f, NumStates * NumActions);
+    Visits.Init(0, NumStates * NumActions);
+    ActionMask.Init(0, NumStates);
+
+    // Нульовий рядок: жадібна дія 0, max Q 0
+    BestActions.Init(0, NumStates);
+    MaxValues.Init(0.0f, NumStates);
+}
+
+void FHighLevelQTable::InvalidateAllRows()
+{
+    FMemory::Memset(BestActions.GetData(), DirtyRow, BestActions.Num());
+}
+
+int32 FHighLevelQTable::PackLevels(const ENeedLevel* Levels)
+{
+    int32 Index = 0;
+    for (int32 i = 0; i < NumNeeds; i++)
+    {
+        Index = Index * NumLevels + (int32)Levels[i];
+    }
+    return Index;
+}
+
+int32 FHighLevelQTable::PackNeedValues(const float* NeedValues)
+{
+    int32 Index = 0;
+    for (int32 i = 0; i < NumNeeds; i++)
+    {
+        Index = Index * NumLevels + (int32)FNPCState::ValueToLevel(NeedValues[i]);
+    }
+    return Index;
+}
+
+void FHighLevelQTable::UnpackLevels(int32 StateIndex, ENeedLevel* OutLevels)
+{
+    for (int32 i = NumNeeds - 1; i >= 0; i--)
+    {
+        OutLevels[i] = (ENeedLevel)(StateIndex % NumLevels);
+        StateIndex /= NumLevels;
+    }
+}
+
+FString FHighLevelQTable::StateIndexToKey(int32 StateIndex)
+{
+    ENeedLevel Levels[NumNeeds];
+    UnpackLevels(StateIndex, Levels);
+
+    FString Key;
+    for (int32 i = 0; i < NumNeeds; i++)
+    {
+        Key += FString::FromInt((int32)Levels[i]);
+    }
+    return Key;
+}
+
+int32 FHighLevelQTable::StateKeyToIndex(const FString& StateKey)
+{
+    if (StateKey.Len() != NumNeeds)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Index = 0;
+    for (int32 i = 0; i < NumNeeds; i++)
+    {
+        const int32 Level = StateKey[i] - TEXT('0');
+        if (Level < 0 || Level >= NumLevels)
+        {
+            return INDEX_NONE;
+        }
+        Index = Index * NumLevels + Level;
+    }
+    return Index;
+}
+
+void FHighLevelQTable::SetValue(int32 StateIndex, int32 Action, float Value)
+{
+    const int32 Slot = StateIndex * NumActions + Action;
+    const uint8 Bit = (uint8)(1 << Action);
+
+    if ((ActionMask[StateIndex] & Bit) == 0)
+    {
+        ActionMask[StateIndex] |= Bit;
+    }
+    else
+    {
+        Visits[Slot]++;
+    }
+
+    Values[Slot] = Value;
+    BestActions[StateIndex] = DirtyRow;
+}
+
+void FHighLevelQTable::RefreshRow(int32 StateIndex) const
+{
+    // При рівності - менший індекс, як і раніше
+    const float* Row = &Values[StateIndex * NumActions];
+    int32 BestAction = 0;
+    for (int32 i = 1; i < NumActions; i++)
+    {
+        if (Row[i] > Row[BestAction])
+        {
+            BestAction = i;
+        }
+    }
+
+    MaxValues[StateIndex] = Row[BestAction];
+    BestActions[StateIndex] = (uint8)BestAction;
+}
+
+void FHighLevelQTable::RefreshDirtyRows() const
+{
+    for (int32 StateIndex = 0; StateIndex < NumStates; StateIndex++)
+    {
+        if (BestActions[StateIndex] == DirtyRow)
+        {
+            RefreshRow(StateIndex);
+        }
+    }
+}
+
+int32 FHighLevelQTable::GetNumStoredStates() const
+{
+    int32 Count = 0;
+    for (uint8 Mask : ActionMask)
+    {
+        Count += Mask != 0 ? 1 : 0;
+    }
+    return Count;
+}
+
+int64 FHighLevelQTable::GetTotalUpdates() const
+{
+    int64 Total = 0;
+    for (int32 StateIndex = 0; StateIndex < NumStates; StateIndex++)
+    {
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            Total += GetUpdates(StateIndex, Action);
+        }
+    }
+    return Total;
+}
+
+bool FHighLevelQTable::SaveToFile(const FString& FullPath) const
+{
+    FString Directory = FPaths::GetPath(FullPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+
+    for (int32 StateIndex = 0; StateIndex < NumStates; StateIndex++)
+    {
+        if (ActionMask[StateIndex] == 0)
+        {
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> StateObject = MakeShareable(new FJsonObject);
+
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            if (!HasValue(StateIndex, Action))
+            {
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> QValueObject = MakeShareable(new FJsonObject);
+            QValueObject->SetNumberField("Value", GetValue(StateIndex, Action));
+            QValueObject->SetNumberField("TimesVisited", GetVisits(StateIndex, Action));
+
+            StateObject->SetObjectField(FString::FromInt(Action), QValueObject);
+        }
+
+        RootObject->SetObjectField(StateIndexToKey(StateIndex), StateObject);
+    }
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+
+    return FFileHelper::SaveStringToFile(OutputString, *FullPath);
+}
+
+bool FHighLevelQTable::LoadFromFile(const FString& FullPath)
+{
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *FullPath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> RootObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to parse High-Level Q-Table JSON: %s"), *FullPath);
+        return false;
+    }
+
+    Reset();
+
+    for (const auto& StatePair : RootObject->Values)
+    {
+        const int32 StateIndex = StateKeyToIndex(StatePair.Key);
+        const TSharedPtr<FJsonObject>* StateObject;
+        if (StateIndex == INDEX_NONE || !StatePair.Value->TryGetObject(StateObject))
+        {
+            continue;
+        }
+
+        for (const auto& ActionPair : (*StateObject)->Values)
+        {
+            const int32 Action = FCString::Atoi(*ActionPair.Key);
+            const TSharedPtr<FJsonObject>* QValueObject;
+            if (Action < 0 || Action >= NumActions || !ActionPair.Value->TryGetObject(QValueObject))
+            {
+                continue;
+            }
+
+            const int32 Slot = StateIndex * NumActions + Action;
+            Values[Slot] = (*QValueObject)->GetNumberField("Value");
+            Visits[Slot] = (*QValueObject)->GetIntegerField("TimesVisited");
+            ActionMask[StateIndex] |= (uint8)(1 << Action);
+        }
+    }
+
+    InvalidateAllRows();
+    return true;
+}
+
+void FHighLevelQTable::SaveToBytes(TArray<uint8>& OutBytes) const
+{
+    const FTableBytesHeader Header = { TableBytesMagic, TableBytesVersion, NumStates, NumActions };
+
+    OutBytes.Reset();
+    OutBytes.Append((const uint8*)&Header, sizeof(Header));
+    OutBytes.Append((const uint8*)Values.GetData(), Values.Num() * sizeof(float));
+    OutBytes.Append((const uint8*)Visits.GetData(), Visits.Num() * sizeof(int32));
+    OutBytes.Append(ActionMask.GetData(), ActionMask.Num());
+}
+
+bool FHighLevelQTable::LoadFromBytes(const uint8* Data, int64 NumBytes)
+{
+    const int64 ValuesBytes = NumStates * NumActions * sizeof(float);
+    const int64 VisitsBytes = NumStates * NumActions * sizeof(int32);
+    const int64 ExpectedBytes = sizeof(FTableBytesHeader) + ValuesBytes + VisitsBytes + NumStates;
+
+    FTableBytesHeader Header;
+    if (!Data || NumBytes != ExpectedBytes)
+    {
+        return false;
+    }
+    FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+    if (Header.Magic != TableBytesMagic || Header.Version != TableBytesVersion ||
+        Header.NumStates != NumStates || Header.NumActions != NumActions)
+    {
+        return false;
+    }
+
+    // Розміри масивів сталі - тільки копіювання, без виділень
+    Data += sizeof(Header);
+    FMemory::Memcpy(Values.GetData(), Data, ValuesBytes);
+    Data += ValuesBytes;
+    FMemory::Memcpy(Visits.GetData(), Data, VisitsBytes);
+    Data += VisitsBytes;
+    FMemory::Memcpy(ActionMask.GetData(), Data, NumStates);
+
+    InvalidateAllRows();
+    return true;
+}
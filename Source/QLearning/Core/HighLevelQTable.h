@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NeedType.h"
+#include "QLearningTypes.h"
+
+// Щільна високорівнева Q-таблиця: стан упаковано в індекс (по цифрі ENeedLevel на потребу),
+// макро-дія = індекс потреби. Формат JSON - Saved/QLearning/HighLevelQTable.json.
+struct QLEARNING_API FHighLevelQTable
+{
+    static constexpr int32 NumNeeds = (int32)ENeedType::MAX;
+    static constexpr int32 NumLevels = (int32)ENeedLevel::MAX;
+    static constexpr int32 NumActions = NumNeeds;
+
+    static constexpr int32 ComputeNumStates()
+    {
+        int32 Result = 1;
+        for (int32 i = 0; i < NumNeeds; i++)
+        {
+            Result *= NumLevels;
+        }
+        return Result;
+    }
+
+    static constexpr int32 NumStates = ComputeNumStates();
+
+    FHighLevelQTable();
+
+    // Перша потреба - старший розряд, тож порядок індексів збігається з порядком ключів
+    static int32 PackLevels(const ENeedLevel* Levels);
+    static int32 PackNeedValues(const float* NeedValues);
+    static void UnpackLevels(int32 StateIndex, ENeedLevel* OutLevels);
+    static FString StateIndexToKey(int32 StateIndex);
+    static int32 StateKeyToIndex(const FString& StateKey);
+
+    float GetValue(int32 StateIndex, int32 Action) const
+    {
+        return Values[StateIndex * NumActions + Action];
+    }
+
+    int32 GetVisits(int32 StateIndex, int32 Action) const
+    {
+        return Visits[StateIndex * NumActions + Action];
+    }
+
+    bool HasValue(int32 StateIndex, int32 Action) const
+    {
+        return (ActionMask[StateIndex] & (1 << Action)) != 0;
+    }
+
+    // Скільки разів пару оновлювали онлайн, включно з першим записом
+    int32 GetUpdates(int32 StateIndex, int32 Action) const
+    {
+        return GetVisits(StateIndex, Action) + (HasValue(StateIndex, Action) ? 1 : 0);
+    }
+
+    // Перший запис не рахується як візит, кожен наступний - рахується
+    void SetValue(int32 StateIndex, int32 Action, float Value);
+
+    // Повторні оновлення (replay, планування) - значення без лічильника візитів
+    void SetValueNoVisit(int32 StateIndex, int32 Action, float Value)
+    {
+        Values[StateIndex * NumActions + Action] = Value;
+        ActionMask[StateIndex] |= (uint8)(1 << Action);
+        BestActions[StateIndex] = DirtyRow;
+    }
+
+    // Кешовані по рядку: запис позначає рядок брудним, argmax перераховується при наступному читанні.
+    // Читання перераховує кеш, тож для спільної таблиці - під тим самим локом, що й запис.
+    float GetMaxValue(int32 StateIndex) const
+    {
+        if (BestActions[StateIndex] == DirtyRow)
+        {
+            RefreshRow(StateIndex);
+        }
+        return MaxValues[StateIndex];
+    }
+
+    int32 GetBestAction(int32 StateIndex) const
+    {
+        if (BestActions[StateIndex] == DirtyRow)
+        {
+            RefreshRow(StateIndex);
+        }
+        return BestActions[StateIndex];
+    }
+
+    // Перераховує всі брудні рядки - після цього читання копії нічого не пише
+    void RefreshDirtyRows() const;
+
+    int32 GetNumStoredStates() const;
+    int64 GetTotalUpdates() const;
+
+    void Reset();
+
+    bool SaveToFile(const FString& FullPath) const;
+    bool LoadFromFile(const FString& FullPath);
+
+    // Двійковий знімок для кукнутого UHighLevelQTableAsset: заголовок і три масиви підряд
+    void SaveToBytes(TArray<uint8>& OutBytes) const;
+    bool LoadFromBytes(const uint8* Data, int64 NumBytes);
+
+    // Пишуть тільки через SetValue / SetValueNoVisit - інакше кеш рядка застаріє
+    TArray<float> Values;
+    TArray<int32> Visits;
+    TArray<uint8> ActionMask;
+
+private:
+    static constexpr uint8 DirtyRow = 0xFF;
+
+    void RefreshRow(int32 StateIndex) const;
+    void InvalidateAllRows();
+
+    mutable TArray<uint8> BestActions;
+    mutable TArray<float> MaxValues;
+};
@@ -0,0 +1,69 @@
+#include "HighLevelQTableAsset.h"
+#include "../Subsystems/QTableCacheSubsystem.h"
+
+const FPrimaryAssetType UHighLevelQTableAsset::AssetType(TEXT("HighLevelQTable"));
+
+void UHighLevelQTableAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    // Вбудований payload приходить разом з ассетом в асинхронному завантаженні
+    TableData.Serialize(Ar, this);
+}
+
+bool UHighLevelQTableAsset::ReadTable(FHighLevelQTable& OutTable) const
+{
+    const int64 NumBytes = TableData.GetBulkDataSize();
+    if (NumBytes == 0)
+    {
+        return false;
+    }
+
+    const uint8* Data = (const uint8*)TableData.LockReadOnly();
+    const bool bLoaded = OutTable.LoadFromBytes(Data, NumBytes);
+    TableData.Unlock();
+
+    if (!bLoaded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: table layout changed since import, reimport the asset"), *GetName());
+    }
+    return bLoaded;
+}
+
+#if WITH_EDITOR
+bool UHighLevelQTableAsset::ImportFromFile(const FString& FullPath)
+{
+    FHighLevelQTable Table;
+    if (!Table.LoadFromFile(FullPath))
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    Table.SaveToBytes(Bytes);
+
+    Modify();
+    // Payload у самому пакеті, а не окремим .ubulk - інакше асинхронне завантаження ассета його не приносить
+    TableData.SetBulkDataFlags(BULKDATA_ForceInlinePayload);
+    TableData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(TableData.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+    TableData.Unlock();
+
+    NumStoredStates = Table.GetNumStoredStates();
+    MarkPackageDirty();
+    return true;
+}
+
+void UHighLevelQTableAsset::ReimportFromSaved()
+{
+    const FString FullPath = UQTableCacheSubsystem::GetTablePath(SourceFilename);
+    if (ImportFromFile(FullPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("✅ %s reimported: %d states from %s"), *GetName(), NumStoredStates, *FullPath);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s: could not import %s"), *GetName(), *FullPath);
+    }
+}
+#endif
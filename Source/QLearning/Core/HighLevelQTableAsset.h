@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Serialization/BulkData.h"
+#include "HighLevelQTable.h"
+#include "HighLevelQTableAsset.generated.h"
+
+// Навчена високорівнева таблиця як кукнутий ассет: двійковий знімок у bulk data.
+// Імпорт - -run=ImportHighLevelQTable або кнопка Reimport From Saved в редакторі.
+// Під час гри вантажиться асинхронно через UAssetManager (UQTableCacheSubsystem).
+UCLASS(BlueprintType)
+class QLEARNING_API UHighLevelQTableAsset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    static const FPrimaryAssetType AssetType;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override { return FPrimaryAssetId(AssetType, GetFName()); }
+    virtual void Serialize(FArchive& Ar) override;
+
+    // false, якщо даних немає або формат таблиці змінився з часу імпорту
+    bool ReadTable(FHighLevelQTable& OutTable) const;
+
+#if WITH_EDITOR
+    bool ImportFromFile(const FString& FullPath);
+
+    UFUNCTION(CallInEditor, Category = "Q-Table")
+    void ReimportFromSaved();
+#endif
+
+    // Файл у Saved/QLearning, з якого імпортовано таблицю
+    UPROPERTY(EditAnywhere, Category = "Q-Table")
+    FString SourceFilename = TEXT("HighLevelQTable.json");
+
+    UPROPERTY(VisibleAnywhere, Category = "Q-Table")
+    int32 NumStoredStates = 0;
+
+private:
+    FByteBulkData TableData;
+};
@@ -0,0 +1,51 @@
+#include "HighLevelReplayBuffer.h"
+
+void FHighLevelReplayBuffer::Init(int32 InCapacity)
+{
+    Transitions.SetNumZeroed(FMath::Max(InCapacity, 1));
+    Reset();
+}
+
+void FHighLevelReplayBuffer::Reset()
+{
+    Head = 0;
+    NumStored = 0;
+    TotalAdded = 0;
+}
+
+void FHighLevelReplayBuffer::Add(const FHighLevelTransition& Transition)
+{
+    Transitions[Head] = Transition;
+    Head = (Head + 1) % Transitions.Num();
+    NumStored = FMath::Min(NumStored + 1, Transitions.Num());
+    TotalAdded++;
+}
+
+int32 FHighLevelReplayBuffer::SampleBatch(FRandomStream& Random, int32 BatchSize,
+                                          TArray<const FHighLevelTransition*>& OutBatch) const
+{
+    OutBatch.Reset();
+    if (NumStored == 0)
+    {
+        return 0;
+    }
+
+    for (int32 i = 0; i < BatchSize; i++)
+    {
+        OutBatch.Add(&Transitions[Random.RandHelper(NumStored)]);
+    }
+    return OutBatch.Num();
+}
+
+void FHighLevelReplayBuffer::ApplyBatch(FHighLevelQTable& Table, const TArray<const FHighLevelTransition*>& Batch,
+                                        float LearningRate)
+{
+    for (const FHighLevelTransition* Transition : Batch)
+    {
+        const float CurrentQ = Table.GetValue(Transition->State, Transition->Action);
+        const float MaxNextQ = Table.GetMaxValue(Transition->NextState);
+        const float NewQ = CurrentQ + LearningRate * (Transition->Reward + Transition->Discount * MaxNextQ - CurrentQ);
+
+        Table.SetValueNoVisit(Transition->State, Transition->Action, NewQ);
+    }
+}
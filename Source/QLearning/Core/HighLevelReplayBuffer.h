@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+
+// Один перехід макро-дії в упакованому вигляді
+struct FHighLevelTransition
+{
+    int32 State = 0;
+    int32 NextState = 0;
+    float Reward = 0.0f;
+    float Duration = 0.0f;
+    // γ, з яким перехід оновлено онлайн (γ^тривалість у режимі SMDP); Reward уже містить штраф за час
+    float Discount = 0.0f;
+    uint8 Action = 0;
+};
+
+// Кільцевий буфер переходів фіксованої ємності. Пам'ять виділяється один раз в Init,
+// далі Add і SampleBatch нічого не алокують.
+class QLEARNING_API FHighLevelReplayBuffer
+{
+public:
+    void Init(int32 InCapacity);
+
+    void Add(const FHighLevelTransition& Transition);
+
+    // Рівномірна вибірка з поверненням; вказівники дійсні до наступного Add
+    int32 SampleBatch(FRandomStream& Random, int32 BatchSize, TArray<const FHighLevelTransition*>& OutBatch) const;
+
+    // TD-оновлення мінібатчу; повторні оновлення не рахуються як візити
+    static void ApplyBatch(FHighLevelQTable& Table, const TArray<const FHighLevelTransition*>& Batch,
+                           float LearningRate);
+
+    int32 Num() const { return NumStored; }
+    int32 GetCapacity() const { return Transitions.Num(); }
+    int64 GetTotalAdded() const { return TotalAdded; }
+    void Reset();
+
+private:
+    TArray<FHighLevelTransition> Transitions;
+    int32 Head = 0;
+    int32 NumStored = 0;
+    int64 TotalAdded = 0;
+};
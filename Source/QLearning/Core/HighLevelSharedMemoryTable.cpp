@@ -0,0 +1,274 @@
+#include "HighLevelSharedMemoryTable.h"
+#include <atomic>
+
+namespace
+{
+    constexpr uint32 SharedTableMagic = 0x4D53484C; // "LHSM"
+    constexpr int32 SharedTableVersion = 1;
+    constexpr int32 NumSharedSlots = FHighLevelQTable::NumStates * FHighLevelQTable::NumActions;
+
+    // Атомарні змінні спільної пам'яті мають працювати між процесами - тільки lock-free
+    static_assert(std::atomic<uint32>::is_always_lock_free, "Shared Q-values need lock-free 32-bit atomics");
+    static_assert(std::atomic<int64>::is_always_lock_free, "Shared counters need lock-free 64-bit atomics");
+
+    uint32 FloatToBits(float Value)
+    {
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    float BitsToFloat(uint32 Bits)
+    {
+        float Value;
+        FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+}
+
+struct FHighLevelSharedMemoryTable::FLayout
+{
+    uint32 Magic;
+    int32 Version;
+    int32 NumStates;
+    int32 NumActions;
+
+    // Координатор виставляє останнім, коли таблиця заповнена
+    std::atomic<int32> Ready;
+    std::atomic<uint32> OwnerProcessId;
+    std::atomic<int32> NumAttached;
+    std::atomic<int64> TotalUpdates;
+
+    std::atomic<uint32> Values[NumSharedSlots];
+    std::atomic<int32> Visits[NumSharedSlots];
+    std::atomic<uint32> ActionMask[FHighLevelQTable::NumStates];
+};
+
+FHighLevelSharedMemoryTable::FHighLevelSharedMemoryTable(FPlatformMemory::FSharedMemoryRegion* InRegion, bool bInOwner)
+    : Region(InRegion)
+    , Layout((FLayout*)InRegion->GetAddress())
+    , bOwner(bInOwner)
+{
+}
+
+FHighLevelSharedMemoryTable::~FHighLevelSharedMemoryTable()
+{
+    if (!bOwner)
+    {
+        Layout->NumAttached.fetch_sub(1);
+    }
+
+    // Власник ще й видаляє ім'я регіону; під'єднані процеси дорахують у вже відображеній пам'яті
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+TUniquePtr<FHighLevelSharedMemoryTable> FHighLevelSharedMemoryTable::Create(const FString& Name, const FHighLevelQTable& Source)
+{
+    const uint32 AccessMode = FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write;
+    const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+
+    // MapNamedSharedMemoryRegion(bCreate = true) відкриває й наявний регіон (без O_EXCL),
+    // тож спершу перевіряємо, чи його вже хтось не тримає
+    bool bAdopt = false;
+    if (FPlatformMemory::FSharedMemoryRegion* Existing = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, AccessMode, sizeof(FLayout)))
+    {
+        // GetSize() - запитаний розмір, а не справжній; заголовок однаковий у всіх версіях, тож читаємо лише його
+        const FLayout* Layout = (const FLayout*)Existing->GetAddress();
+        const bool bCompatible = Layout->Magic == SharedTableMagic && Layout->Version == SharedTableVersion &&
+            Layout->NumStates == FHighLevelQTable::NumStates && Layout->NumActions == FHighLevelQTable::NumActions;
+        const uint32 OwnerProcessId = bCompatible ? Layout->OwnerProcessId.load() : 0;
+
+        // Живий координатор - навіть якщо ще заповнює таблицю
+        if (OwnerProcessId != 0 && OwnerProcessId != ProcessId && FPlatformProcess::IsApplicationRunning(OwnerProcessId))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Shared Q-table region %s is already in use (coordinator process %u)"), *Name, OwnerProcessId);
+            FPlatformMemory::UnmapNamedSharedMemoryRegion(Existing);
+            return nullptr;
+        }
+
+        // Координатор впав після заповнення - процеси могли вчитися далі, їхні значення не затираємо файлом.
+        // Інший формат або недозаповнений регіон заповнюємо наново
+        bAdopt = bCompatible && Layout->Ready.load() != 0;
+        if (bAdopt)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Shared Q-table region %s adopted from exited coordinator %u: %lld updates, %d processes"),
+                   *Name, OwnerProcessId, Layout->TotalUpdates.load(), Layout->NumAttached.load());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Shared Q-table region %s is stale or has a different layout, reinitializing it"), *Name);
+        }
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Existing);
+    }
+
+    // bCreate = true і для переймання: тоді власник видалить ім'я регіону при виході
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, true, AccessMode, sizeof(FLayout));
+    if (!Region)
+    {
+        return nullptr;
+    }
+
+    FLayout* Layout = (FLayout*)Region->GetAddress();
+    TUniquePtr<FHighLevelSharedMemoryTable> Table(new FHighLevelSharedMemoryTable(Region, true));
+    if (bAdopt)
+    {
+        Layout->OwnerProcessId.store(ProcessId);
+        return Table;
+    }
+
+    // Заголовок пишемо наново: регіон новий (нулі) або від іншої версії; до Ready ніхто не під'єднається
+    Layout->Ready.store(0);
+    Layout->Magic = SharedTableMagic;
+    Layout->Version = SharedTableVersion;
+    Layout->NumStates = FHighLevelQTable::NumStates;
+    Layout->NumActions = FHighLevelQTable::NumActions;
+    Layout->NumAttached.store(0);
+    Layout->OwnerProcessId.store(ProcessId);
+
+    Table->CopyFrom(Source);
+
+    Layout->Ready.store(1);
+    return Table;
+}
+
+TUniquePtr<FHighLevelSharedMemoryTable> FHighLevelSharedMemoryTable::Attach(const FString& Name)
+{
+    FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+        Name, false, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, sizeof(FLayout));
+    if (!Region)
+    {
+        return nullptr;
+    }
+
+    const FLayout* Layout = (const FLayout*)Region->GetAddress();
+    if (Layout->Ready.load() == 0 || Layout->Magic != SharedTableMagic ||
+        Layout->Version != SharedTableVersion || Layout->NumStates != FHighLevelQTable::NumStates ||
+        Layout->NumActions != FHighLevelQTable::NumActions)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Shared Q-table region %s is not ready or has a different layout"), *Name);
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        return nullptr;
+    }
+
+    TUniquePtr<FHighLevelSharedMemoryTable> Table(new FHighLevelSharedMemoryTable(Region, false));
+    Table->Layout->NumAttached.fetch_add(1);
+    return Table;
+}
+
+void FHighLevelSharedMemoryTable::Evaluate(const float* Observation, float* OutValues) const
+{
+    const int32 Row = FHighLevelQTable::PackNeedValues(Observation) * NumActions;
+    for (int32 Action = 0; Action < NumActions; Action++)
+    {
+        OutValues[Action] = BitsToFloat(Layout->Values[Row + Action].load(std::memory_order_relaxed));
+    }
+}
+
+void FHighLevelSharedMemoryTable::Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                                        const float* NextObservation, float Alpha)
+{
+    const int32 StateIndex = FHighLevelQTable::PackNeedValues(Observation);
+    const int32 Slot = StateIndex * NumActions + Action;
+    const float Target = Reward + Discount * GetMaxValue(NextObservation);
+
+    // Інший процес міг оновити ту саму пару між читанням і записом - тоді рахуємо від його значення
+    std::atomic<uint32>& Value = Layout->Values[Slot];
+    uint32 OldBits = Value.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const float OldQ = BitsToFloat(OldBits);
+        const uint32 NewBits = FloatToBits(OldQ + Alpha * (Target - OldQ));
+        if (Value.compare_exchange_weak(OldBits, NewBits, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    // Як FHighLevelQTable::SetValue: перший запис не рахується як візит
+    const uint32 Bit = 1u << Action;
+    if ((Layout->ActionMask[StateIndex].fetch_or(Bit, std::memory_order_relaxed) & Bit) != 0)
+    {
+        Layout->Visits[Slot].fetch_add(1, std::memory_order_relaxed);
+    }
+    Layout->TotalUpdates.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FHighLevelSharedMemoryTable::Reset()
+{
+    // Під'єднаний процес не може стерти таблицю, в яку вчаться інші
+    if (bOwner)
+    {
+        CopyFrom(FHighLevelQTable());
+    }
+}
+
+void FHighLevelSharedMemoryTable::CopyTo(FHighLevelQTable& OutTable) const
+{
+    OutTable.Reset();
+    for (int32 StateIndex = 0; StateIndex < FHighLevelQTable::NumStates; StateIndex++)
+    {
+        const uint32 Mask = Layout->ActionMask[StateIndex].load(std::memory_order_relaxed);
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            if ((Mask & (1u << Action)) == 0)
+            {
+                continue;
+            }
+
+            const int32 Slot = StateIndex * NumActions + Action;
+            OutTable.SetValueNoVisit(StateIndex, Action, BitsToFloat(Layout->Values[Slot].load(std::memory_order_relaxed)));
+            OutTable.Visits[Slot] = Layout->Visits[Slot].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void FHighLevelSharedMemoryTable::CopyFrom(const FHighLevelQTable& Source)
+{
+    int64 TotalUpdates = 0;
+    for (int32 StateIndex = 0; StateIndex < FHighLevelQTable::NumStates; StateIndex++)
+    {
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            const int32 Slot = StateIndex * NumActions + Action;
+            Layout->Values[Slot].store(FloatToBits(Source.GetValue(StateIndex, Action)), std::memory_order_relaxed);
+            Layout->Visits[Slot].store(Source.GetVisits(StateIndex, Action), std::memory_order_relaxed);
+            TotalUpdates += Source.GetUpdates(StateIndex, Action);
+        }
+        Layout->ActionMask[StateIndex].store(Source.ActionMask[StateIndex], std::memory_order_relaxed);
+    }
+    Layout->TotalUpdates.store(TotalUpdates);
+}
+
+bool FHighLevelSharedMemoryTable::SaveToFile(const FString& FullPath) const
+{
+    if (!bOwner)
+    {
+        return false;
+    }
+
+    FHighLevelQTable Snapshot;
+    CopyTo(Snapshot);
+    return Snapshot.SaveToFile(FullPath);
+}
+
+bool FHighLevelSharedMemoryTable::LoadFromFile(const FString& FullPath)
+{
+    FHighLevelQTable Loaded;
+    if (!bOwner || !Loaded.LoadFromFile(FullPath))
+    {
+        return false;
+    }
+
+    CopyFrom(Loaded);
+    return true;
+}
+
+int64 FHighLevelSharedMemoryTable::GetTotalUpdates() const
+{
+    return Layout->TotalUpdates.load();
+}
+
+int32 FHighLevelSharedMemoryTable::GetNumAttached() const
+{
+    return Layout->NumAttached.load();
+}
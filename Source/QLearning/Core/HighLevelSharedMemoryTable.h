@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelValueBackend.h"
+#include "HAL/PlatformMemory.h"
+
+// Щільна високорівнева таблиця в іменованій спільній пам'яті (shm_open на Linux): кілька headless-процесів
+// на одному хості вчаться в одну таблицю без файлів. Регіон створює і зберігає координатор
+// (-run=QTableCoordinator), ігрові процеси тільки під'єднуються.
+// Q - атомарні float (CAS по бітах), візити і маска дій - атомарні лічильники; замків немає.
+class QLEARNING_API FHighLevelSharedMemoryTable : public FHighLevelValueBackend
+{
+public:
+    static constexpr const TCHAR* DefaultRegionName = TEXT("QLearningHighLevel");
+
+    ~FHighLevelSharedMemoryTable();
+
+    // Координатор: новий регіон, заповнений з Source. Регіон координатора, що впав, переймається
+    // як є (він новіший за файл), недозаповнений чи іншого формату - заповнюється з Source;
+    // nullptr, якщо живий координатор уже тримає регіон
+    static TUniquePtr<FHighLevelSharedMemoryTable> Create(const FString& Name, const FHighLevelQTable& Source);
+
+    // Ігровий процес: nullptr, якщо координатор не запущений або формат таблиці інший
+    static TUniquePtr<FHighLevelSharedMemoryTable> Attach(const FString& Name);
+
+    virtual void Evaluate(const float* Observation, float* OutValues) const override;
+    virtual void Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                       const float* NextObservation, float Alpha) override;
+    virtual void Reset() override;
+
+    // Той самий JSON, що й у щільної таблиці; зберігає і завантажує тільки власник регіону
+    virtual FString GetFileName() const override { return TEXT("HighLevelQTable.json"); }
+    virtual bool SaveToFile(const FString& FullPath) const override;
+    virtual bool LoadFromFile(const FString& FullPath) override;
+
+    // Знімок для контрольної точки; рядки, які саме оновлюються, можуть бути на одне оновлення новіші
+    void CopyTo(FHighLevelQTable& OutTable) const;
+    void CopyFrom(const FHighLevelQTable& Source);
+
+    virtual int64 GetTotalUpdates() const override;
+    // Процес, що впав, не встигає від'єднатися - лічильник тільки для логів
+    int32 GetNumAttached() const;
+    bool IsOwner() const { return bOwner; }
+
+private:
+    FHighLevelSharedMemoryTable(FPlatformMemory::FSharedMemoryRegion* InRegion, bool bInOwner);
+
+    struct FLayout;
+
+    FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+    FLayout* Layout = nullptr;
+    bool bOwner = false;
+};
@@ -0,0 +1,149 @@
+#include "HighLevelTileCoding.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+    constexpr uint32 TileCodingMagic = 0x43544C51; // "QLTC"
+    constexpr int32 TileCodingVersion = 1;
+}
+
+FHighLevelTileCoding::FHighLevelTileCoding(int32 InNumTilings, int32 InTilesPerNeed, int32 InMemorySize)
+    : NumTilings(FMath::Clamp(InNumTilings, 1, MaxTilings))
+    , TilesPerNeed(FMath::Max(InTilesPerNeed, 1))
+    , MemorySize((int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(InMemorySize, 64)))
+{
+    Reset();
+}
+
+void FHighLevelTileCoding::Reset()
+{
+    Weights.Init(0.0f, MemorySize * ActionStride);
+}
+
+void FHighLevelTileCoding::GetActiveTiles(const float* NeedValues, int32* OutRows) const
+{
+    float Scaled[NumNeeds];
+    for (int32 Need = 0; Need < NumNeeds; Need++)
+    {
+        Scaled[Need] = FMath::Clamp(NeedValues[Need], 0.0f, 100.0f) / 100.0f * TilesPerNeed;
+    }
+
+    for (int32 Tiling = 0; Tiling < NumTilings; Tiling++)
+    {
+        uint32 Hash = HashCombineFast(0x9E3779B9u, (uint32)Tiling);
+
+        // Асиметричні зсуви (1, 3, 5, ...) / NumTilings, щоб сітки не збігались по діагоналі
+        for (int32 Need = 0; Need < NumNeeds; Need++)
+        {
+            const float Offset = FMath::Fractional((float)(Tiling * (2 * Need + 1)) / NumTilings);
+            Hash = HashCombineFast(Hash, (uint32)FMath::FloorToInt32(Scaled[Need] + Offset));
+        }
+
+        OutRows[Tiling] = (int32)(Hash & (uint32)(MemorySize - 1)) * ActionStride;
+    }
+}
+
+void FHighLevelTileCoding::Evaluate(const float* Observation, float* OutValues) const
+{
+    int32 Rows[MaxTilings];
+    GetActiveTiles(Observation, Rows);
+
+    const float* WeightData = Weights.GetData();
+    VectorRegister4Float SumLow = VectorZeroFloat();
+    VectorRegister4Float SumHigh = VectorZeroFloat();
+
+    for (int32 Tiling = 0; Tiling < NumTilings; Tiling++)
+    {
+        const float* Row = WeightData + Rows[Tiling];
+        SumLow = VectorAdd(SumLow, VectorLoadAligned(Row));
+        SumHigh = VectorAdd(SumHigh, VectorLoadAligned(Row + 4));
+    }
+
+    alignas(16) float Sums[ActionStride];
+    VectorStoreAligned(SumLow, Sums);
+    VectorStoreAligned(SumHigh, Sums + 4);
+
+    for (int32 Action = 0; Action < NumActions; Action++)
+    {
+        OutValues[Action] = Sums[Action];
+    }
+}
+
+void FHighLevelTileCoding::Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                                 const float* NextObservation, float Alpha)
+{
+    const float Target = Reward + Discount * GetMaxValue(NextObservation);
+
+    int32 Rows[MaxTilings];
+    GetActiveTiles(Observation, Rows);
+
+    float Current = 0.0f;
+    for (int32 Tiling = 0; Tiling < NumTilings; Tiling++)
+    {
+        Current += Weights[Rows[Tiling] + Action];
+    }
+
+    // Крок ділиться між сітками, тож Alpha має той самий масштаб, що й у таблиці
+    const float Step = Alpha * (Target - Current) / NumTilings;
+    for (int32 Tiling = 0; Tiling < NumTilings; Tiling++)
+    {
+        Weights[Rows[Tiling] + Action] += Step;
+    }
+}
+
+bool FHighLevelTileCoding::SaveToFile(const FString& FullPath) const
+{
+    FString Directory = FPaths::GetPath(FullPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = TileCodingMagic;
+    int32 Version = TileCodingVersion;
+    int32 SavedTilings = NumTilings;
+    int32 SavedTilesPerNeed = TilesPerNeed;
+    int32 SavedMemorySize = MemorySize;
+    Writer << Magic << Version << SavedTilings << SavedTilesPerNeed << SavedMemorySize;
+    Writer.Serialize(const_cast<float*>(Weights.GetData()), Weights.Num() * sizeof(float));
+
+    return FFileHelper::SaveArrayToFile(Bytes, *FullPath);
+}
+
+bool FHighLevelTileCoding::LoadFromFile(const FString& FullPath)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FullPath))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 SavedTilings = 0;
+    int32 SavedTilesPerNeed = 0;
+    int32 SavedMemorySize = 0;
+    Reader << Magic << Version << SavedTilings << SavedTilesPerNeed << SavedMemorySize;
+
+    // Ваги іншої конфігурації хешуються в інші рядки - використовувати їх не можна
+    if (Magic != TileCodingMagic || Version != TileCodingVersion || SavedTilings != NumTilings ||
+        SavedTilesPerNeed != TilesPerNeed || SavedMemorySize != MemorySize ||
+        Bytes.Num() - Reader.Tell() != Weights.Num() * (int64)sizeof(float))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Tile coding weights in %s don't match the current configuration"), *FullPath);
+        return false;
+    }
+
+    Reader.Serialize(Weights.GetData(), Weights.Num() * sizeof(float));
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelValueBackend.h"
+
+// Лінійна апроксимація Q поверх tile coding сирих потреб (перші NumNeeds значень спостереження).
+// NumTilings зсунутих сіток по TilesPerNeed клітинок на потребу; координати клітинки хешуються
+// в таблицю ваг фіксованого розміру, тож пам'ять не залежить від роздільності.
+// Ваги зберігаються рядком на клітинку з усіма макро-діями поруч, тож Evaluate -
+// сума NumTilings векторних рядків (добуток бінарних ознак на матрицю ваг).
+class QLEARNING_API FHighLevelTileCoding : public FHighLevelValueBackend
+{
+public:
+    static constexpr int32 MaxTilings = 32;
+
+    // Рядок ваг вирівняно до двох SIMD-регістрів
+    static constexpr int32 ActionStride = 8;
+    static_assert(NumActions <= ActionStride, "Macro actions don't fit into one weight row");
+
+    FHighLevelTileCoding(int32 InNumTilings = 8, int32 InTilesPerNeed = 10, int32 InMemorySize = 4096);
+
+    virtual void Evaluate(const float* Observation, float* OutValues) const override;
+    virtual void Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                       const float* NextObservation, float Alpha) override;
+    virtual void Reset() override;
+
+    virtual FString GetFileName() const override { return TEXT("HighLevelTileCoding.bin"); }
+    virtual bool SaveToFile(const FString& FullPath) const override;
+    virtual bool LoadFromFile(const FString& FullPath) override;
+
+    int32 GetNumTilings() const { return NumTilings; }
+    int32 GetMemorySize() const { return MemorySize; }
+
+private:
+    // Індекс рядка ваг для кожної сітки
+    void GetActiveTiles(const float* NeedValues, int32* OutRows) const;
+
+    int32 NumTilings = 8;
+    int32 TilesPerNeed = 10;
+    int32 MemorySize = 4096;
+
+    TArray<float, TAlignedHeapAllocator<16>> Weights;
+};
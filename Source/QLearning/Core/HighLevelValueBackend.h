@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HighLevelQTable.h"
+
+// Альтернатива щільній таблиці: Q(s, a) як функція від неперервного спостереження.
+// UHighLevelQLearning звертається до неї тими самими ChooseMacroAction / UpdateQValue.
+class QLEARNING_API FHighLevelValueBackend
+{
+public:
+    static constexpr int32 NumNeeds = FHighLevelQTable::NumNeeds;
+    static constexpr int32 NumActions = FHighLevelQTable::NumActions;
+
+    // Спостереження: [0, NumNeeds) - сирі потреби 0..100, далі для кожної макро-дії
+    // відстань до найближчого вільного об'єкта (0..1) і скільки таких об'єктів вільно (0..1)
+    static constexpr int32 NumObservations = NumNeeds + 2 * NumActions;
+    static constexpr int32 DistanceOffset = NumNeeds;
+    static constexpr int32 FreeCountOffset = NumNeeds + NumActions;
+
+    virtual ~FHighLevelValueBackend() = default;
+
+    // Q для всіх макро-дій одразу; OutValues - NumActions елементів
+    virtual void Evaluate(const float* Observation, float* OutValues) const = 0;
+
+    // Num спостережень підряд (крок NumObservations) -> Num * NumActions значень
+    virtual void EvaluateBatch(const float* Observations, int32 Num, float* OutValues) const
+    {
+        for (int32 i = 0; i < Num; i++)
+        {
+            Evaluate(Observations + i * NumObservations, OutValues + i * NumActions);
+        }
+    }
+
+    // Один перехід макро-дії; Discount - γ для цього переходу (γ^тривалість у режимі SMDP)
+    virtual void Learn(const float* Observation, int32 Action, float Reward, float Discount,
+                       const float* NextObservation, float Alpha) = 0;
+
+    virtual void Reset() = 0;
+
+    // Ім'я файлу в Saved/QLearning/
+    virtual FString GetFileName() const = 0;
+    virtual bool SaveToFile(const FString& FullPath) const = 0;
+    virtual bool LoadFromFile(const FString& FullPath) = 0;
+
+    // Скільки оновлень уже в значеннях - з нього продовжується спад дослідження; 0, якщо файл лічильника не зберігає
+    virtual int64 GetTotalUpdates() const { return 0; }
+
+    static float GetMaxOf(const float* Values)
+    {
+        float MaxValue = Values[0];
+        for (int32 Action = 1; Action < NumActions; Action++)
+        {
+            MaxValue = FMath::Max(MaxValue, Values[Action]);
+        }
+        return MaxValue;
+    }
+
+    static int32 GetBestOf(const float* Values)
+    {
+        int32 BestAction = 0;
+        for (int32 Action = 1; Action < NumActions; Action++)
+        {
+            if (Values[Action] > Values[BestAction])
+            {
+                BestAction = Action;
+            }
+        }
+        return BestAction;
+    }
+
+    float GetMaxValue(const float* Observation) const
+    {
+        float Values[NumActions];
+        Evaluate(Observation, Values);
+        return GetMaxOf(Values);
+    }
+
+    int32 GetBestAction(const float* Observation) const
+    {
+        float Values[NumActions];
+        Evaluate(Observation, Values);
+        return GetBestOf(Values);
+    }
+};
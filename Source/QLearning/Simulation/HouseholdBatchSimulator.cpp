@@ -0,0 +1,400 @@
+#include "HouseholdBatchSimulator.h"
+#include "../Actors/InteractableObject.h"
+#include "../Actors/NPCSpawnManager.h"
+#include "../Characters/NPCCharacter.h"
+#include "../Components/NeedsComponent.h"
+#include "Engine/Level.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+void FHouseholdSimConfig::ReadNeedParameters(const UNeedsComponent* NeedsTemplate, int32 MaxGeneration)
+{
+    if (!NeedsTemplate)
+    {
+        NeedsTemplate = GetDefault<UNeedsComponent>();
+    }
+
+    BaseDegradationRate = NeedsTemplate->BaseDegradationRate;
+
+    DifficultyByGeneration.SetNum(MaxGeneration + 1);
+    StartValueByGeneration.SetNum(MaxGeneration + 1);
+    for (int32 Gen = 0; Gen <= MaxGeneration; Gen++)
+    {
+        DifficultyByGeneration[Gen] = NeedsTemplate->CalculateDifficultyMultiplier(Gen);
+        StartValueByGeneration[Gen] = NeedsTemplate->CalculateStartValue(Gen);
+    }
+}
+
+FHouseholdSimConfig FHouseholdSimConfig::FromWorld(UWorld* World)
+{
+    FHouseholdSimConfig Config;
+    const ANPCCharacter* NPCTemplate = GetDefault<ANPCCharacter>();
+
+    if (!World || !World->PersistentLevel)
+    {
+        Config.ReadNeedParameters(NPCTemplate->NeedsComponent);
+        return Config;
+    }
+
+    for (AActor* Actor : World->PersistentLevel->Actors)
+    {
+        if (AInteractableObject* Object = Cast<AInteractableObject>(Actor))
+        {
+            FHouseholdInteractableSpec& Spec = Config.Interactables.AddDefaulted_GetRef();
+            Spec.ActionType = Object->ActionType;
+            Spec.Location = Object->GetActorLocation();
+            Spec.InteractionDuration = Object->InteractionDuration;
+            Spec.NeedModifiers = Object->GetNeedModifiers();
+        }
+        else if (ANPCSpawnManager* Manager = Cast<ANPCSpawnManager>(Actor))
+        {
+            if (Manager->NPCClass)
+            {
+                NPCTemplate = Manager->NPCClass->GetDefaultObject<ANPCCharacter>();
+            }
+
+            for (ATargetPoint* Point : Manager->SpawnPoints)
+            {
+                if (Point)
+                {
+                    Config.SpawnLocations.Add(Point->GetActorLocation());
+                }
+            }
+        }
+        else if (ATargetPoint* Point = Cast<ATargetPoint>(Actor))
+        {
+            if (Point->ActorHasTag(FName("NPCSpawn")))
+            {
+                Config.SpawnLocations.AddUnique(Point->GetActorLocation());
+            }
+        }
+    }
+
+    if (NPCTemplate->GetCharacterMovement())
+    {
+        Config.WalkSpeed = NPCTemplate->GetCharacterMovement()->MaxWalkSpeed;
+    }
+    Config.ReadNeedParameters(NPCTemplate->NeedsComponent);
+
+    UE_LOG(LogTemp, Warning, TEXT("Household sim config: %d interactables, %d spawn points, WalkSpeed=%.0f"),
+           Config.Interactables.Num(), Config.SpawnLocations.Num(), Config.WalkSpeed);
+
+    return Config;
+}
+
+FHouseholdBatchSimulator::FHouseholdBatchSimulator(const FHouseholdSimConfig& InConfig, FHighLevelQTable& InTable)
+    : Config(InConfig)
+    , Table(InTable)
+{
+    if (Config.SpawnLocations.Num() == 0)
+    {
+        Config.SpawnLocations.Add(FVector::ZeroVector);
+    }
+
+    if (Config.DifficultyByGeneration.Num() == 0)
+    {
+        Config.ReadNeedParameters(nullptr);
+    }
+
+    NumEnvironments = FMath::Max(1, Config.NumEnvironments);
+    RecentLifetimes = FRollingLifetimeStats(NumEnvironments);
+
+    BuildRoutes();
+    Reset();
+}
+
+void FHouseholdBatchSimulator::BuildRoutes()
+{
+    const int32 NumActions = FHighLevelQTable::NumActions;
+    const int32 NumNeeds = FHighLevelQTable::NumNeeds;
+    const int32 NumObjects = Config.Interactables.Num();
+
+    NumSpawnNodes = Config.SpawnLocations.Num();
+    const int32 NumNodes = NumSpawnNodes + NumObjects;
+
+    ObjectDuration.SetNumUninitialized(NumObjects);
+    ObjectNeedDelta.Init(0.0f, NumObjects * NumNeeds);
+    for (int32 Obj = 0; Obj < NumObjects; Obj++)
+    {
+        const FHouseholdInteractableSpec& Spec = Config.Interactables[Obj];
+        ObjectDuration[Obj] = Spec.InteractionDuration;
+        for (const FNeedModifier& Modifier : Spec.NeedModifiers)
+        {
+            ObjectNeedDelta[Obj * NumNeeds + (int32)Modifier.NeedType] += Modifier.ModifierValue;
+        }
+    }
+
+    // Найближчий об'єкт кожного типу з кожного вузла, як у GetInteractableObjectsForAction
+    RouteObject.Init(INDEX_NONE, NumNodes * NumActions);
+    RouteTravelTime.Init(0.0f, NumNodes * NumActions);
+
+    for (int32 Node = 0; Node < NumNodes; Node++)
+    {
+        const FVector From = Node < NumSpawnNodes
+            ? Config.SpawnLocations[Node]
+            : Config.Interactables[Node - NumSpawnNodes].Location;
+
+        for (int32 Action = 0; Action < NumActions; Action++)
+        {
+            const EActionType ActionType = UHighLevelQLearning::GetActionTypeForMacroAction((EMacroAction)Action);
+            float BestDistSq = TNumericLimits<float>::Max();
+
+            for (int32 Obj = 0; Obj < NumObjects; Obj++)
+            {
+                if (Config.Interactables[Obj].ActionType != ActionType)
+                {
+                    continue;
+                }
+
+                const float DistSq = FVector::DistSquared(From, Config.Interactables[Obj].Location);
+                if (DistSq < BestDistSq)
+                {
+                    BestDistSq = DistSq;
+                    RouteObject[Node * NumActions + Action] = Obj;
+                }
+            }
+
+            if (RouteObject[Node * NumActions + Action] != INDEX_NONE)
+            {
+                const float Distance = FMath::Max(0.0f, FMath::Sqrt(BestDistSq) - Config.AcceptanceRadius);
+                RouteTravelTime[Node * NumActions + Action] = Distance / FMath::Max(1.0f, Config.WalkSpeed);
+            }
+        }
+    }
+}
+
+void FHouseholdBatchSimulator::Reset()
+{
+    Random.Initialize(Config.Seed);
+    Params = Config.Params;
+
+    for (int32 Need = 0; Need < FHighLevelQTable::NumNeeds; Need++)
+    {
+        Needs[Need].SetNumUninitialized(NumEnvironments);
+    }
+    Location.SetNumUninitialized(NumEnvironments);
+    Generation.SetNumUninitialized(NumEnvironments);
+    Lifetime.SetNumUninitialized(NumEnvironments);
+
+    StepState.SetNumUninitialized(NumEnvironments);
+    StepAction.SetNumUninitialized(NumEnvironments);
+    StepObject.SetNumUninitialized(NumEnvironments);
+    StepDecay.SetNumUninitialized(NumEnvironments);
+
+    for (int32 Env = 0; Env < NumEnvironments; Env++)
+    {
+        Generation[Env] = Config.StartGeneration;
+        ResetEnvironment(Env);
+    }
+
+    TotalDecisions = 0;
+    TotalDeaths = 0;
+    ExplorationProgress = Table.GetTotalUpdates();
+    UpdateExplorationRate();
+    RecentLifetimes.Reset();
+    WallSeconds = 0.0;
+    ResetStats();
+}
+
+void FHouseholdBatchSimulator::ResetStats()
+{
+    StatDeaths = 0;
+    StatLifetimeSum = 0.0;
+}
+
+double FHouseholdBatchSimulator::GetMeanCurrentLifetime() const
+{
+    double Sum = 0.0;
+    for (float Age : Lifetime)
+    {
+        Sum += Age;
+    }
+    return Sum / NumEnvironments;
+}
+
+void FHouseholdBatchSimulator::ResetEnvironment(int32 Env)
+{
+    const float StartValue = GetStartValue(Generation[Env]);
+    for (int32 Need = 0; Need < FHighLevelQTable::NumNeeds; Need++)
+    {
+        Needs[Need][Env] = StartValue;
+    }
+
+    Location[Env] = Random.RandRange(0, NumSpawnNodes - 1);
+    Lifetime[Env] = 0.0f;
+}
+
+float FHouseholdBatchSimulator::GetDifficulty(int32 Gen) const
+{
+    return Config.DifficultyByGeneration[FMath::Clamp(Gen, 0, Config.DifficultyByGeneration.Num() - 1)];
+}
+
+float FHouseholdBatchSimulator::GetStartValue(int32 Gen) const
+{
+    return Config.StartValueByGeneration[FMath::Clamp(Gen, 0, Config.StartValueByGeneration.Num() - 1)];
+}
+
+void FHouseholdBatchSimulator::UpdateQ(int32 StateIndex, int32 Action, float Reward, int32 NextStateIndex, float Duration)
+{
+    const float CurrentQ = Table.GetValue(StateIndex, Action);
+    const float MaxNextQ = Table.GetMaxValue(NextStateIndex);
+
+    // Те саме SMDP-правило, що й у UHighLevelQLearning::UpdateQValue
+    const float TotalReward = Reward + UHighLevelQLearning::GetOptionDecayPenalty(Params, Duration);
+    const float Discount = UHighLevelQLearning::GetDurationDiscount(Params, Duration);
+
+    const float NewQ = CurrentQ + Params.LearningRate *
+                       (TotalReward + Discount * MaxNextQ - CurrentQ);
+
+    Table.SetValue(StateIndex, Action, NewQ);
+}
+
+void FHouseholdBatchSimulator::Step()
+{
+    const int32 NumActions = FHighLevelQTable::NumActions;
+    const int32 NumNeeds = FHighLevelQTable::NumNeeds;
+
+    // 1. Вибір дій: safety net як у ANPCCharacter::MakeDecision, інакше epsilon-greedy
+    for (int32 Env = 0; Env < NumEnvironments; Env++)
+    {
+        float Values[FHighLevelQTable::NumNeeds];
+        int32 CriticalNeed = INDEX_NONE;
+        float LowestValue = Config.EmergencyThreshold;
+
+        for (int32 Need = 0; Need < NumNeeds; Need++)
+        {
+            Values[Need] = Needs[Need][Env];
+            if (Values[Need] < LowestValue)
+            {
+                LowestValue = Values[Need];
+                CriticalNeed = Need;
+            }
+        }
+
+        const int32 StateIndex = FHighLevelQTable::PackNeedValues(Values);
+        int32 Action = CriticalNeed;
+        if (Action == INDEX_NONE)
+        {
+            Action = Random.FRand() < CurrentExplorationRate
+                ? Random.RandRange(0, NumActions - 1)
+                : Table.GetBestAction(StateIndex);
+        }
+
+        const int32 Route = Location[Env] * NumActions + Action;
+        const int32 Object = RouteObject[Route];
+        const float Elapsed = Object != INDEX_NONE
+            ? RouteTravelTime[Route] + ObjectDuration[Object]
+            : Config.FailureRetryTime;
+
+        StepState[Env] = StateIndex;
+        StepAction[Env] = Action;
+        StepObject[Env] = Object;
+        StepDecay[Env] = Config.BaseDegradationRate * GetDifficulty(Generation[Env]) * Elapsed;
+    }
+
+    // 2. Деградація потреб за час дії
+    for (int32 Need = 0; Need < NumNeeds; Need++)
+    {
+        float* RESTRICT NeedValues = Needs[Need].GetData();
+        const float* RESTRICT Decay = StepDecay.GetData();
+        for (int32 Env = 0; Env < NumEnvironments; Env++)
+        {
+            NeedValues[Env] -= Decay[Env];
+        }
+    }
+
+    // 3. Смерть або модифікатори, нагорода і оновлення спільної таблиці
+    for (int32 Env = 0; Env < NumEnvironments; Env++)
+    {
+        float Values[FHighLevelQTable::NumNeeds];
+        float MinValue = TNumericLimits<float>::Max();
+        for (int32 Need = 0; Need < NumNeeds; Need++)
+        {
+            Values[Need] = Needs[Need][Env];
+            MinValue = FMath::Min(MinValue, Values[Need]);
+        }
+
+        const int32 Action = StepAction[Env];
+        const int32 Object = StepObject[Env];
+        const float Elapsed = Object != INDEX_NONE
+            ? RouteTravelTime[Location[Env] * NumActions + Action] + ObjectDuration[Object]
+            : Config.FailureRetryTime;
+
+        if (MinValue <= 0.0f)
+        {
+            // Всі потреби деградують однаково, тож смерть настала на частці дії MinBefore / Decay
+            const float Decay = StepDecay[Env];
+            const float SurvivedFraction = Decay > 0.0f ? FMath::Clamp((MinValue + Decay) / Decay, 0.0f, 1.0f) : 0.0f;
+
+            for (int32 Need = 0; Need < NumNeeds; Need++)
+            {
+                Values[Need] = FMath::Max(0.0f, Values[Need]);
+            }
+
+            UpdateQ(StepState[Env], Action, UHighLevelQLearning::DeathPenalty,
+                    FHighLevelQTable::PackNeedValues(Values), Elapsed * SurvivedFraction);
+
+            Lifetime[Env] += Elapsed * SurvivedFraction;
+            StatLifetimeSum += Lifetime[Env];
+            RecentLifetimes.Add(Lifetime[Env]);
+            StatDeaths++;
+            TotalDeaths++;
+
+            Generation[Env]++;
+            ResetEnvironment(Env);
+            continue;
+        }
+
+        const bool bSuccess = Object != INDEX_NONE;
+
+        if (bSuccess)
+        {
+            const float* Delta = &ObjectNeedDelta[Object * NumNeeds];
+            for (int32 Need = 0; Need < NumNeeds; Need++)
+            {
+                Values[Need] = FMath::Clamp(Values[Need] + Delta[Need], 0.0f, 100.0f);
+                Needs[Need][Env] = Values[Need];
+            }
+
+            Location[Env] = NumSpawnNodes + Object;
+        }
+
+        const float Reward = UHighLevelQLearning::CalculateMacroActionReward((EMacroAction)Action, bSuccess, Values);
+        UpdateQ(StepState[Env], Action, Reward, FHighLevelQTable::PackNeedValues(Values), Elapsed);
+
+        Lifetime[Env] += Elapsed;
+    }
+
+    // Кожне домогосподарство зробило одне оновлення - NumEnvironments кроків графіка, як у грі
+    ExplorationProgress += NumEnvironments;
+    UpdateExplorationRate();
+
+    TotalDecisions += NumEnvironments;
+}
+
+void FHouseholdBatchSimulator::SetParams(const FHLQLearningParams& InParams)
+{
+    Params = InParams;
+    ExplorationProgress = Table.GetTotalUpdates();
+    UpdateExplorationRate();
+}
+
+void FHouseholdBatchSimulator::UpdateExplorationRate()
+{
+    CurrentExplorationRate = FHighLevelExploration::GetDecayedValue(Params.ExplorationRate, Params.MinExplorationRate,
+                                                                    Params.ExplorationDecay, ExplorationProgress);
+}
+
+void FHouseholdBatchSimulator::Run(int64 NumDecisions)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    const int64 NumSteps = FMath::DivideAndRoundUp(NumDecisions, (int64)NumEnvironments);
+    for (int64 i = 0; i < NumSteps; i++)
+    {
+        Step();
+    }
+
+    WallSeconds += FPlatformTime::Seconds() - StartTime;
+}
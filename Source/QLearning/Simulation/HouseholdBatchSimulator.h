@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Core/QLearningTypes.h"
+#include "../Core/HighLevelQTable.h"
+#include "../Components/HighLevelQLearning.h"
+#include "../Utils/GenerationLogger.h"
+
+class UWorld;
+class UNeedsComponent;
+
+struct FHouseholdInteractableSpec
+{
+    EActionType ActionType = EActionType::Idle;
+    FVector Location = FVector::ZeroVector;
+    float InteractionDuration = 10.0f;
+    TArray<FNeedModifier> NeedModifiers;
+};
+
+// Параметри headless-симуляції. FromWorld читає ті самі об'єкти та потреби, що й рівень.
+struct QLEARNING_API FHouseholdSimConfig
+{
+    TArray<FHouseholdInteractableSpec> Interactables;
+    TArray<FVector> SpawnLocations;
+
+    float WalkSpeed = 600.0f;
+    float AcceptanceRadius = 150.0f;
+    // Скільки в середньому NPC чекає на звільнення об'єкта після невдалої спроби
+    float FailureRetryTime = 2.0f;
+    float EmergencyThreshold = 25.0f;
+    float BaseDegradationRate = 1.0f;
+
+    // Криві curriculum за поколінням, останній елемент діє для всіх старших поколінь
+    TArray<float> DifficultyByGeneration;
+    TArray<float> StartValueByGeneration;
+    int32 StartGeneration = 0;
+
+    FHLQLearningParams Params;
+    int32 NumEnvironments = 1024;
+    int32 Seed = 0;
+
+    void ReadNeedParameters(const UNeedsComponent* NeedsTemplate, int32 MaxGeneration = 400);
+    static FHouseholdSimConfig FromWorld(UWorld* World);
+};
+
+// Крокує тисячі абстрактних домогосподарств синхронно (struct-of-arrays),
+// всі пишуть в одну спільну щільну Q-таблицю.
+class QLEARNING_API FHouseholdBatchSimulator
+{
+public:
+    FHouseholdBatchSimulator(const FHouseholdSimConfig& InConfig, FHighLevelQTable& InTable);
+
+    void Reset();
+
+    // Одне макро-рішення для кожного середовища
+    void Step();
+    void Run(int64 NumDecisions);
+
+    void ResetStats();
+    int64 GetTotalDecisions() const { return TotalDecisions; }
+    int64 GetTotalDeaths() const { return TotalDeaths; }
+    double GetMeanLifetime() const { return StatDeaths > 0 ? StatLifetimeSum / StatDeaths : 0.0; }
+    int64 GetStatDeaths() const { return StatDeaths; }
+    // Середній вік живих домогосподарств - нижня межа тривалості життя, коли смертей ще немає
+    double GetMeanCurrentLifetime() const;
+    double GetStepsPerSecond() const { return WallSeconds > 0.0 ? TotalDecisions / WallSeconds : 0.0; }
+    float GetExplorationRate() const { return CurrentExplorationRate; }
+    // Останні NumEnvironments смертей; не скидається в ResetStats
+    const FRollingLifetimeStats& GetRecentLifetimes() const { return RecentLifetimes; }
+    void ResetRecentLifetimes() { RecentLifetimes.Reset(); }
+
+    // ExplorationRate - початок графіка; поточне значення - GetExplorationRate().
+    // Заміна діє з наступного кроку, прогрес графіка перечитується з таблиці (вона могла бути скопійована)
+    const FHLQLearningParams& GetParams() const { return Params; }
+    void SetParams(const FHLQLearningParams& InParams);
+    int32 GetNumEnvironments() const { return NumEnvironments; }
+
+private:
+    void BuildRoutes();
+    void ResetEnvironment(int32 Env);
+    void UpdateExplorationRate();
+    void UpdateQ(int32 StateIndex, int32 Action, float Reward, int32 NextStateIndex, float Duration);
+    float GetDifficulty(int32 Generation) const;
+    float GetStartValue(int32 Generation) const;
+
+    FHouseholdSimConfig Config;
+    FHighLevelQTable& Table;
+    FHLQLearningParams Params;
+    FRandomStream Random;
+    int32 NumEnvironments = 0;
+
+    // Стан середовищ (SoA)
+    TArray<float> Needs[FHighLevelQTable::NumNeeds];
+    TArray<int32> Location;
+    TArray<int32> Generation;
+    TArray<float> Lifetime;
+
+    // Скретч-буфери одного кроку
+    TArray<int32> StepState;
+    TArray<int32> StepAction;
+    TArray<int32> StepObject;
+    TArray<float> StepDecay;
+
+    // Вузли: спочатку точки спавну, потім об'єкти. Маршрут [вузол * NumActions + дія]
+    int32 NumSpawnNodes = 0;
+    TArray<int32> RouteObject;
+    TArray<float> RouteTravelTime;
+    TArray<float> ObjectDuration;
+    TArray<float> ObjectNeedDelta;
+
+    int64 TotalDecisions = 0;
+    // Оновлення таблиці - той самий прогрес, що й у UHighLevelQLearning::GetExplorationProgress
+    int64 ExplorationProgress = 0;
+    float CurrentExplorationRate = 0.0f;
+    int64 TotalDeaths = 0;
+    int64 StatDeaths = 0;
+    double StatLifetimeSum = 0.0;
+    FRollingLifetimeStats RecentLifetimes;
+    double WallSeconds = 0.0;
+};
@@ -0,0 +1,193 @@
+#include "HouseholdPopulationTrainer.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "../Utils/CSVFormat.h"
+
+FHouseholdPopulationTrainer::FHouseholdPopulationTrainer(const FHouseholdSimConfig& InBaseConfig,
+                                                         const FHouseholdPopulationConfig& InConfig)
+    : BaseConfig(InBaseConfig)
+    , Config(InConfig)
+    , Random(InConfig.Seed)
+{
+    Config.PopulationSize = FMath::Max(Config.PopulationSize, 2);
+    Config.ExploitIntervalDecisions = FMath::Max<int64>(Config.ExploitIntervalDecisions, 1);
+    Config.TruncationFraction = FMath::Clamp(Config.TruncationFraction, 0.0f, 0.5f);
+    Config.PerturbFactor = FMath::Max(Config.PerturbFactor, 1.0f);
+
+    // Посилання на таблиці тримають симулятори - масив більше не змінює розмір
+    Tables.SetNum(Config.PopulationSize);
+    Simulators.SetNum(Config.PopulationSize);
+
+    for (int32 Member = 0; Member < Config.PopulationSize; Member++)
+    {
+        FHouseholdSimConfig MemberConfig = BaseConfig;
+        MemberConfig.Seed = Config.Seed + Member;
+
+        // Перший учень - параметри як є, решта розкидані навколо них
+        if (Member > 0)
+        {
+            MemberConfig.Params = Perturb(BaseConfig.Params, true);
+        }
+
+        Simulators[Member] = MakeUnique<FHouseholdBatchSimulator>(MemberConfig, Tables[Member]);
+    }
+
+    History = TEXT("Interval;Member;Decisions;RollingLifetime;LearningRate;DiscountFactor;ExplorationRate;ExplorationDecay;MinExplorationRate;CopiedFrom\n");
+}
+
+float FHouseholdPopulationTrainer::ScaleHorizon(float Value, float Factor)
+{
+    return FMath::Clamp(1.0f - (1.0f - Value) / Factor, 0.5f, 0.99999f);
+}
+
+FHLQLearningParams FHouseholdPopulationTrainer::Perturb(const FHLQLearningParams& Source, bool bInitial)
+{
+    // Початкове розкидання - неперервне в [1/2, 2], далі - крок PerturbFactor в один бік
+    auto NextFactor = [this, bInitial]()
+    {
+        if (bInitial)
+        {
+            return FMath::Pow(2.0f, Random.FRandRange(-1.0f, 1.0f));
+        }
+        return Random.FRand() < 0.5f ? Config.PerturbFactor : 1.0f / Config.PerturbFactor;
+    };
+
+    FHLQLearningParams Result = Source;
+    Result.LearningRate = FMath::Clamp(Source.LearningRate * NextFactor(), 0.001f, 1.0f);
+    Result.DiscountFactor = ScaleHorizon(Source.DiscountFactor, NextFactor());
+    Result.ExplorationDecay = ScaleHorizon(Source.ExplorationDecay, NextFactor());
+    Result.MinExplorationRate = FMath::Clamp(Source.MinExplorationRate * NextFactor(), 0.001f, 0.5f);
+    Result.ExplorationRate = FMath::Clamp(Source.ExplorationRate * NextFactor(), Result.MinExplorationRate, 1.0f);
+    return Result;
+}
+
+int32 FHouseholdPopulationTrainer::GetBestMember() const
+{
+    int32 BestMember = 0;
+    for (int32 Member = 1; Member < Simulators.Num(); Member++)
+    {
+        if (GetRollingLifetime(Member) > GetRollingLifetime(BestMember))
+        {
+            BestMember = Member;
+        }
+    }
+    return BestMember;
+}
+
+void FHouseholdPopulationTrainer::Run()
+{
+    const int32 NumIntervals = (int32)FMath::DivideAndRoundUp(Config.DecisionsPerMember, Config.ExploitIntervalDecisions);
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (int32 Interval = 1; Interval <= NumIntervals; Interval++)
+    {
+        const int64 Target = FMath::Min(Config.ExploitIntervalDecisions * Interval, Config.DecisionsPerMember);
+
+        // Учні не ділять нічого, крім BaseConfig (тільки читання)
+        ParallelFor(Simulators.Num(), [this, Target](int32 Member)
+        {
+            FHouseholdBatchSimulator& Simulator = *Simulators[Member];
+            Simulator.Run(Target - Simulator.GetTotalDecisions());
+        });
+
+        const int32 BestMember = GetBestMember();
+        UE_LOG(LogTemp, Display, TEXT("PopulationTraining: interval %d/%d, best member %d RollingLifetime=%.1fs (LR=%.3f, Gamma=%.3f), %.1fs elapsed"),
+               Interval, NumIntervals, BestMember, GetRollingLifetime(BestMember),
+               GetParams(BestMember).LearningRate, GetParams(BestMember).DiscountFactor,
+               FPlatformTime::Seconds() - StartTime);
+
+        if (Interval < NumIntervals)
+        {
+            ExploitAndExplore(Interval);
+        }
+        else
+        {
+            for (int32 Member = 0; Member < Simulators.Num(); Member++)
+            {
+                RecordHistory(Interval, Member, INDEX_NONE);
+            }
+        }
+    }
+}
+
+void FHouseholdPopulationTrainer::ExploitAndExplore(int32 Interval)
+{
+    // Порівнюємо тільки учнів з повним вікном смертей
+    TArray<int32> Ranked;
+    for (int32 Member = 0; Member < Simulators.Num(); Member++)
+    {
+        if (Simulators[Member]->GetRecentLifetimes().IsFull())
+        {
+            Ranked.Add(Member);
+        }
+    }
+
+    Ranked.Sort([this](int32 A, int32 B)
+    {
+        return GetRollingLifetime(A) > GetRollingLifetime(B);
+    });
+
+    const int32 NumTruncated = FMath::FloorToInt(Ranked.Num() * Config.TruncationFraction);
+
+    TArray<int32> CopiedFrom;
+    CopiedFrom.Init(INDEX_NONE, Simulators.Num());
+
+    for (int32 Rank = Ranked.Num() - NumTruncated; Rank < Ranked.Num(); Rank++)
+    {
+        CopiedFrom[Ranked[Rank]] = Ranked[Random.RandHelper(NumTruncated)];
+    }
+
+    // Історія - зі статистикою до копіювання
+    for (int32 Member = 0; Member < Simulators.Num(); Member++)
+    {
+        RecordHistory(Interval, Member, CopiedFrom[Member]);
+    }
+
+    for (int32 Member = 0; Member < Simulators.Num(); Member++)
+    {
+        const int32 Source = CopiedFrom[Member];
+        if (Source == INDEX_NONE)
+        {
+            continue;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("PopulationTraining: member %d (%.1fs) <- member %d (%.1fs)"),
+               Member, GetRollingLifetime(Member), Source, GetRollingLifetime(Source));
+
+        Tables[Member] = Tables[Source];
+        Simulators[Member]->SetParams(Perturb(Simulators[Source]->GetParams(), false));
+        Simulators[Member]->ResetRecentLifetimes();
+    }
+}
+
+void FHouseholdPopulationTrainer::RecordHistory(int32 Interval, int32 Member, int32 CopiedFrom)
+{
+    const FHouseholdBatchSimulator& Simulator = *Simulators[Member];
+    const FHLQLearningParams& Params = Simulator.GetParams();
+
+    History += FString::Printf(TEXT("%d;%d;%lld;%s;%s;%s;%s;%s;%s;%d\n"),
+        Interval,
+        Member,
+        Simulator.GetTotalDecisions(),
+        *FormatCSVFloat(Simulator.GetRecentLifetimes().GetMean()),
+        *FormatCSVFloat(Params.LearningRate),
+        *FormatCSVFloat(Params.DiscountFactor),
+        *FormatCSVFloat(Simulator.GetExplorationRate()),
+        *FormatCSVFloat(Params.ExplorationDecay),
+        *FormatCSVFloat(Params.MinExplorationRate),
+        CopiedFrom);
+}
+
+bool FHouseholdPopulationTrainer::SaveHistory(const FString& FullPath) const
+{
+    FString Directory = FPaths::GetPath(FullPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    return FFileHelper::SaveStringToFile(History, *FullPath);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HouseholdBatchSimulator.h"
+
+struct QLEARNING_API FHouseholdPopulationConfig
+{
+    int32 PopulationSize = 8;
+    int64 DecisionsPerMember = 20000000;
+
+    // Як часто найгірші копіюють найкращих
+    int64 ExploitIntervalDecisions = 500000;
+
+    // Частка знизу, що копіює, і частка зверху, яку копіюють
+    float TruncationFraction = 0.25f;
+
+    // Після копіювання кожен параметр множиться на PerturbFactor або 1 / PerturbFactor
+    float PerturbFactor = 1.2f;
+
+    int32 Seed = 0;
+};
+
+// Population-based training: N учнів з різними FHLQLearningParams, у кожного своя таблиця
+// і своє headless-середовище. Раз на інтервал учні з нижньої частки за ковзною тривалістю
+// життя забирають таблицю й збурені параметри випадкового учня з верхньої частки.
+class QLEARNING_API FHouseholdPopulationTrainer
+{
+public:
+    FHouseholdPopulationTrainer(const FHouseholdSimConfig& InBaseConfig, const FHouseholdPopulationConfig& InConfig);
+
+    void Run();
+
+    int32 GetBestMember() const;
+    const FHighLevelQTable& GetTable(int32 Member) const { return Tables[Member]; }
+    const FHLQLearningParams& GetParams(int32 Member) const { return Simulators[Member]->GetParams(); }
+    float GetRollingLifetime(int32 Member) const { return Simulators[Member]->GetRecentLifetimes().GetMean(); }
+
+    // Історія інтервалів у форматі ';' - для графіків траєкторій параметрів
+    bool SaveHistory(const FString& FullPath) const;
+
+private:
+    // Множник на ймовірність "не досліджувати": DiscountFactor і ExplorationDecay змінюють горизонт
+    static float ScaleHorizon(float Value, float Factor);
+    FHLQLearningParams Perturb(const FHLQLearningParams& Source, bool bInitial);
+    void ExploitAndExplore(int32 Interval);
+    void RecordHistory(int32 Interval, int32 Member, int32 CopiedFrom);
+
+    FHouseholdSimConfig BaseConfig;
+    FHouseholdPopulationConfig Config;
+    FRandomStream Random;
+
+    TArray<FHighLevelQTable> Tables;
+    TArray<TUniquePtr<FHouseholdBatchSimulator>> Simulators;
+
+    FString History;
+};
@@ -0,0 +1,290 @@
+#include "HouseholdSweep.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "../Utils/CSVFormat.h"
+
+bool FHouseholdSweepAxis::Parse(const FString& Text, FHouseholdSweepAxis& OutAxis)
+{
+    FString Name;
+    FString ValueText;
+    if (!Text.TrimStartAndEnd().Split(TEXT("="), &Name, &ValueText) || !IsKnownName(Name.TrimStartAndEnd()))
+    {
+        return false;
+    }
+
+    OutAxis = FHouseholdSweepAxis();
+    OutAxis.Name = Name.TrimStartAndEnd();
+
+    TArray<FString> Range;
+    ValueText.ParseIntoArray(Range, TEXT(":"));
+    if (Range.Num() >= 2)
+    {
+        OutAxis.Min = FCString::Atof(*Range[0]);
+        OutAxis.Max = FCString::Atof(*Range[1]);
+        OutAxis.bLogScale = Range.Num() > 2 && Range[2] == TEXT("log");
+
+        // Для сітки - кінці діапазону
+        OutAxis.Values = { OutAxis.Min, OutAxis.Max };
+        return !OutAxis.bLogScale || (OutAxis.Min > 0.0f && OutAxis.Max > 0.0f);
+    }
+
+    TArray<FString> Items;
+    ValueText.ParseIntoArray(Items, TEXT(","));
+    if (Items.Num() == 0)
+    {
+        return false;
+    }
+
+    OutAxis.Min = TNumericLimits<float>::Max();
+    OutAxis.Max = TNumericLimits<float>::Lowest();
+    for (const FString& Item : Items)
+    {
+        const float Value = FCString::Atof(*Item);
+        OutAxis.Values.Add(Value);
+        OutAxis.Min = FMath::Min(OutAxis.Min, Value);
+        OutAxis.Max = FMath::Max(OutAxis.Max, Value);
+    }
+    return true;
+}
+
+bool FHouseholdSweepAxis::IsKnownName(const FString& Name)
+{
+    static const TCHAR* KnownNames[] = {
+        TEXT("LearningRate"), TEXT("DiscountFactor"), TEXT("ExplorationRate"), TEXT("ExplorationDecay"),
+        TEXT("MinExplorationRate"), TEXT("SMDPTimeUnit"), TEXT("DecayPenaltyPerSecond"),
+        TEXT("DifficultyScale"), TEXT("StartValueScale")
+    };
+
+    for (const TCHAR* Known : KnownNames)
+    {
+        if (Name == Known)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FHouseholdSweepAxis::Apply(FHouseholdSimConfig& Config, const FString& Name, float Value)
+{
+    FHLQLearningParams& Params = Config.Params;
+
+    if (Name == TEXT("LearningRate"))               Params.LearningRate = Value;
+    else if (Name == TEXT("DiscountFactor"))        Params.DiscountFactor = Value;
+    else if (Name == TEXT("ExplorationRate"))       Params.ExplorationRate = Value;
+    else if (Name == TEXT("ExplorationDecay"))      Params.ExplorationDecay = Value;
+    else if (Name == TEXT("MinExplorationRate"))    Params.MinExplorationRate = Value;
+    else if (Name == TEXT("SMDPTimeUnit"))          Params.SMDPTimeUnit = Value;
+    else if (Name == TEXT("DecayPenaltyPerSecond")) Params.DecayPenaltyPerSecond = Value;
+    else if (Name == TEXT("DifficultyScale"))
+    {
+        for (float& Difficulty : Config.DifficultyByGeneration)
+        {
+            Difficulty *= Value;
+        }
+    }
+    else if (Name == TEXT("StartValueScale"))
+    {
+        for (float& StartValue : Config.StartValueByGeneration)
+        {
+            StartValue = FMath::Clamp(StartValue * Value, 1.0f, 100.0f);
+        }
+    }
+}
+
+FHouseholdSweep::FHouseholdSweep(const FHouseholdSimConfig& InBaseConfig, const FHouseholdSweepSpec& InSpec)
+    : BaseConfig(InBaseConfig)
+    , Spec(InSpec)
+{
+    Spec.CheckpointDecisions = FMath::Max<int64>(Spec.CheckpointDecisions, 1);
+    Spec.DecisionsPerConfig = FMath::Max(Spec.DecisionsPerConfig, Spec.CheckpointDecisions);
+
+    // Криві потрібні до масштабування DifficultyScale / StartValueScale
+    if (BaseConfig.DifficultyByGeneration.Num() == 0)
+    {
+        BaseConfig.ReadNeedParameters(nullptr);
+    }
+
+    BuildConfigurations();
+}
+
+void FHouseholdSweep::BuildConfigurations()
+{
+    Results.Reset();
+    const int32 NumAxes = Spec.Axes.Num();
+
+    if (Spec.NumRandomSamples > 0)
+    {
+        FRandomStream Random(Spec.Seed);
+        for (int32 Sample = 0; Sample < Spec.NumRandomSamples; Sample++)
+        {
+            FHouseholdSweepResult& Result = Results.AddDefaulted_GetRef();
+            for (const FHouseholdSweepAxis& Axis : Spec.Axes)
+            {
+                const float Alpha = Random.FRand();
+                Result.AxisValues.Add(Axis.bLogScale
+                    ? FMath::Exp(FMath::Lerp(FMath::Loge(Axis.Min), FMath::Loge(Axis.Max), Alpha))
+                    : FMath::Lerp(Axis.Min, Axis.Max, Alpha));
+            }
+        }
+        return;
+    }
+
+    // Повна сітка: лічильник з основами Values.Num() по кожній осі
+    int32 NumConfigs = 1;
+    for (const FHouseholdSweepAxis& Axis : Spec.Axes)
+    {
+        NumConfigs *= Axis.Values.Num();
+    }
+
+    for (int32 ConfigIndex = 0; ConfigIndex < NumConfigs; ConfigIndex++)
+    {
+        FHouseholdSweepResult& Result = Results.AddDefaulted_GetRef();
+        Result.AxisValues.SetNumUninitialized(NumAxes);
+
+        int32 Remainder = ConfigIndex;
+        for (int32 AxisIndex = NumAxes - 1; AxisIndex >= 0; AxisIndex--)
+        {
+            const TArray<float>& Values = Spec.Axes[AxisIndex].Values;
+            Result.AxisValues[AxisIndex] = Values[Remainder % Values.Num()];
+            Remainder /= Values.Num();
+        }
+    }
+}
+
+void FHouseholdSweep::Run()
+{
+    const int32 NumConfigs = Results.Num();
+
+    TArray<FHighLevelQTable> Tables;
+    Tables.SetNum(NumConfigs);
+
+    TArray<TUniquePtr<FHouseholdBatchSimulator>> Simulators;
+    Simulators.SetNum(NumConfigs);
+    for (int32 ConfigIndex = 0; ConfigIndex < NumConfigs; ConfigIndex++)
+    {
+        FHouseholdSimConfig Config = BaseConfig;
+        Config.Seed = Spec.Seed;
+        for (int32 AxisIndex = 0; AxisIndex < Spec.Axes.Num(); AxisIndex++)
+        {
+            FHouseholdSweepAxis::Apply(Config, Spec.Axes[AxisIndex].Name, Results[ConfigIndex].AxisValues[AxisIndex]);
+        }
+        Simulators[ConfigIndex] = MakeUnique<FHouseholdBatchSimulator>(Config, Tables[ConfigIndex]);
+    }
+
+    TArray<int32> LiveConfigs;
+    for (int32 ConfigIndex = 0; ConfigIndex < NumConfigs; ConfigIndex++)
+    {
+        LiveConfigs.Add(ConfigIndex);
+    }
+
+    const int32 NumCheckpoints = (int32)FMath::DivideAndRoundUp(Spec.DecisionsPerConfig, Spec.CheckpointDecisions);
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (int32 Checkpoint = 1; Checkpoint <= NumCheckpoints && LiveConfigs.Num() > 0; Checkpoint++)
+    {
+        const int64 CheckpointTarget = FMath::Min(Spec.CheckpointDecisions * Checkpoint, Spec.DecisionsPerConfig);
+
+        // Кожна конфігурація пише тільки у свій симулятор, таблицю і результат
+        ParallelFor(LiveConfigs.Num(), [&](int32 LiveIndex)
+        {
+            const int32 ConfigIndex = LiveConfigs[LiveIndex];
+            FHouseholdBatchSimulator& Simulator = *Simulators[ConfigIndex];
+            FHouseholdSweepResult& Result = Results[ConfigIndex];
+
+            Simulator.ResetStats();
+            Simulator.Run(CheckpointTarget - Simulator.GetTotalDecisions());
+
+            Result.Decisions = Simulator.GetTotalDecisions();
+            Result.FinalMeanLifetime = Simulator.GetStatDeaths() > 0
+                ? Simulator.GetMeanLifetime() : Simulator.GetMeanCurrentLifetime();
+            Result.BestMeanLifetime = FMath::Max(Result.BestMeanLifetime, Result.FinalMeanLifetime);
+
+            if (Result.DecisionsToThreshold < 0 && Result.FinalMeanLifetime >= Spec.ThresholdLifetime)
+            {
+                Result.DecisionsToThreshold = Result.Decisions;
+            }
+        });
+
+        double BestLifetime = 0.0;
+        for (int32 ConfigIndex : LiveConfigs)
+        {
+            BestLifetime = FMath::Max(BestLifetime, Results[ConfigIndex].FinalMeanLifetime);
+        }
+
+        // Рання зупинка: на тій самій кількості рішень явно гірша за лідера
+        int32 NumStopped = 0;
+        if (Checkpoint >= Spec.MinCheckpoints && Checkpoint < NumCheckpoints)
+        {
+            for (int32 LiveIndex = LiveConfigs.Num() - 1; LiveIndex >= 0; LiveIndex--)
+            {
+                const int32 ConfigIndex = LiveConfigs[LiveIndex];
+                if (Results[ConfigIndex].FinalMeanLifetime < BestLifetime * Spec.DominanceRatio)
+                {
+                    Results[ConfigIndex].bStoppedEarly = true;
+                    Simulators[ConfigIndex].Reset();
+                    LiveConfigs.RemoveAtSwap(LiveIndex);
+                    NumStopped++;
+                }
+            }
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("HouseholdSweep: checkpoint %d/%d (%lld decisions), best MeanLifetime=%.1fs, %d stopped, %d live, %.1fs elapsed"),
+               Checkpoint, NumCheckpoints, CheckpointTarget, BestLifetime, NumStopped, LiveConfigs.Num(),
+               FPlatformTime::Seconds() - StartTime);
+    }
+}
+
+bool FHouseholdSweep::SaveResults(const FString& FullPath) const
+{
+    FString Directory = FPaths::GetPath(FullPath);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    TArray<int32> Order;
+    for (int32 ConfigIndex = 0; ConfigIndex < Results.Num(); ConfigIndex++)
+    {
+        Order.Add(ConfigIndex);
+    }
+
+    // Дійшли до кінця - вище за зупинені, далі за фінальною тривалістю життя
+    Order.Sort([this](int32 A, int32 B)
+    {
+        if (Results[A].bStoppedEarly != Results[B].bStoppedEarly)
+        {
+            return !Results[A].bStoppedEarly;
+        }
+        return Results[A].FinalMeanLifetime > Results[B].FinalMeanLifetime;
+    });
+
+    FString Output = TEXT("Config");
+    for (const FHouseholdSweepAxis& Axis : Spec.Axes)
+    {
+        Output += TEXT(";") + Axis.Name;
+    }
+    Output += TEXT(";DecisionsToThreshold;FinalMeanLifetime;BestMeanLifetime;Decisions;StoppedEarly\n");
+
+    for (int32 ConfigIndex : Order)
+    {
+        const FHouseholdSweepResult& Result = Results[ConfigIndex];
+
+        Output += FString::FromInt(ConfigIndex);
+        for (float Value : Result.AxisValues)
+        {
+            Output += TEXT(";") + FormatCSVFloat(Value);
+        }
+        Output += FString::Printf(TEXT(";%lld;%s;%s;%lld;%d\n"),
+            Result.DecisionsToThreshold,
+            *FormatCSVFloat(Result.FinalMeanLifetime),
+            *FormatCSVFloat(Result.BestMeanLifetime),
+            Result.Decisions,
+            Result.bStoppedEarly ? 1 : 0);
+    }
+
+    return FFileHelper::SaveStringToFile(Output, *FullPath);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HouseholdBatchSimulator.h"
+
+// Одна вісь пошуку: явний список значень (сітка) або діапазон (випадковий пошук)
+struct QLEARNING_API FHouseholdSweepAxis
+{
+    FString Name;
+    TArray<float> Values;
+    float Min = 0.0f;
+    float Max = 0.0f;
+    bool bLogScale = false;
+
+    // "LearningRate=0.1,0.2,0.4" або "ExplorationDecay=0.99:0.9999:log"
+    static bool Parse(const FString& Text, FHouseholdSweepAxis& OutAxis);
+
+    // Параметри FHLQLearningParams, SMDP-параметри і масштаби кривих curriculum
+    static bool IsKnownName(const FString& Name);
+    static void Apply(FHouseholdSimConfig& Config, const FString& Name, float Value);
+};
+
+struct QLEARNING_API FHouseholdSweepSpec
+{
+    TArray<FHouseholdSweepAxis> Axes;
+
+    // 0 - повна сітка зі списків Values; інакше стільки випадкових точок
+    int32 NumRandomSamples = 0;
+
+    int64 DecisionsPerConfig = 5000000;
+    int64 CheckpointDecisions = 250000;
+
+    // Середня тривалість життя, яку вважаємо "навченим" NPC
+    float ThresholdLifetime = 600.0f;
+
+    // Конфігурація зупиняється, якщо на контрольній точці має менше DominanceRatio від найкращої
+    float DominanceRatio = 0.5f;
+    int32 MinCheckpoints = 3;
+
+    int32 Seed = 0;
+};
+
+struct QLEARNING_API FHouseholdSweepResult
+{
+    TArray<float> AxisValues;
+
+    // -1, якщо поріг не досягнуто
+    int64 DecisionsToThreshold = -1;
+    double FinalMeanLifetime = 0.0;
+    double BestMeanLifetime = 0.0;
+    int64 Decisions = 0;
+    bool bStoppedEarly = false;
+};
+
+// Кожна конфігурація - власна таблиця і FHouseholdBatchSimulator з тим самим зерном.
+// Живі конфігурації крокують до наступної контрольної точки паралельно (по одній на ядро).
+class QLEARNING_API FHouseholdSweep
+{
+public:
+    FHouseholdSweep(const FHouseholdSimConfig& InBaseConfig, const FHouseholdSweepSpec& InSpec);
+
+    void Run();
+
+    const TArray<FHouseholdSweepResult>& GetResults() const { return Results; }
+
+    // Таблиця з ';', відсортована за фінальною тривалістю життя
+    bool SaveResults(const FString& FullPath) const;
+
+private:
+    void BuildConfigurations();
+
+    FHouseholdSimConfig BaseConfig;
+    FHouseholdSweepSpec Spec;
+    TArray<FHouseholdSweepResult> Results;
+};
@@ -0,0 +1,525 @@
+#include "HighLevelLearningSubsystem.h"
+#include "QTableCacheSubsystem.h"
+#include "../Actors/NPCSpawnManager.h"
+#include "EngineUtils.h"
+#include "Async/Async.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+
+class FHighLevelPlanningWorker : public FRunnable
+{
+public:
+    FHighLevelPlanningWorker(UHighLevelLearningSubsystem* InOwner, float InIntervalSeconds)
+        : Owner(InOwner)
+        , IntervalSeconds(InIntervalSeconds)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        while (!bStopRequested)
+        {
+            Owner->RunPlanningCycle();
+            FPlatformProcess::Sleep(IntervalSeconds);
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopRequested = true;
+    }
+
+private:
+    UHighLevelLearningSubsystem* Owner;
+    float IntervalSeconds;
+    std::atomic<bool> bStopRequested{false};
+};
+
+class FHighLevelLearnerWorker : public FRunnable
+{
+public:
+    FHighLevelLearnerWorker(UHighLevelLearningSubsystem* InOwner, uint32 InMaxWaitMs)
+        : Owner(InOwner)
+        , MaxWaitMs(InMaxWaitMs)
+        , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    {
+    }
+
+    virtual ~FHighLevelLearnerWorker() override
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    }
+
+    virtual uint32 Run() override
+    {
+        while (!bStopRequested)
+        {
+            // Спимо до нового переходу; таймаут - щоб публікувати зміни планування і без переходів
+            if (Owner->RunLearnerCycle() == 0)
+            {
+                WakeEvent->Wait(MaxWaitMs);
+            }
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopRequested = true;
+        WakeEvent->Trigger();
+    }
+
+    void Wake() { WakeEvent->Trigger(); }
+
+private:
+    UHighLevelLearningSubsystem* Owner;
+    uint32 MaxWaitMs;
+    FEvent* WakeEvent;
+    std::atomic<bool> bStopRequested{false};
+};
+
+bool UHighLevelLearningSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHighLevelLearningSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Collection.InitializeDependency<UQTableCacheSubsystem>();
+
+    Random.Initialize(FPlatformTime::Cycles());
+}
+
+void UHighLevelLearningSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Налаштування менеджера спавну - до BeginPlay акторів: NPC, розставлені на рівні,
+    // можуть прив'язатися до таблиці раніше, ніж BeginPlay самого менеджера
+    for (TActorIterator<ANPCSpawnManager> It(&InWorld); It; ++It)
+    {
+        It->ConfigureLearning(*this);
+        break;
+    }
+}
+
+FHighLevelQTable& UHighLevelLearningSubsystem::GetSharedTable()
+{
+    EnsureSharedTableLoaded();
+    return SharedTable;
+}
+
+void UHighLevelLearningSubsystem::EnsureSharedTableLoaded()
+{
+    // Перший NPC, що вчиться, а не старт світу: із замороженою політикою таблиця не потрібна зовсім
+    if (bSharedTableLoaded)
+    {
+        return;
+    }
+    bSharedTableLoaded = true;
+
+    UQTableCacheSubsystem* Cache = GetWorld() ? GetWorld()->GetSubsystem<UQTableCacheSubsystem>() : nullptr;
+    const FHighLevelQTable* Cached = Cache ? Cache->FindOrLoad(TEXT("HighLevelQTable.json")) : nullptr;
+
+    FScopeLock Lock(&TableLock);
+    if (Cached)
+    {
+        SharedTable = *Cached;
+    }
+    NumOnlineUpdates = SharedTable.GetTotalUpdates();
+
+    // Учень міг уже опублікувати порожню таблицю
+    if (LearnerThread)
+    {
+        PublishedPolicy.Publish(SharedTable);
+    }
+}
+
+void UHighLevelLearningSubsystem::Deinitialize()
+{
+    // Учень першим: він ще може додавати переходи в буфер повторів
+    StopLearnerThread();
+    StopPlanningThread();
+    WaitForReplayTask();
+
+    UE_LOG(LogTemp, Warning, TEXT("High-level replay: %lld transitions, %lld replayed updates, %lld planning updates, %lld async updates"),
+           ReplayBuffer.GetTotalAdded(), NumReplayUpdates, NumPlanningUpdates.load(), NumAsyncUpdates.load());
+
+    if (SharedDQN)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("High-level DQN: %lld train steps, last loss %.3f"),
+               SharedDQN->GetNumTrainSteps(), SharedDQN->GetLastLoss());
+    }
+
+    // Від'єднуємося одразу, а не коли GC прибере підсистему - координатор рахує процеси
+    SharedMemoryTable.Reset();
+
+    Super::Deinitialize();
+}
+
+void UHighLevelLearningSubsystem::WaitForReplayTask()
+{
+    if (ReplayTask.IsValid())
+    {
+        ReplayTask.Wait();
+        ReplayTask.Reset();
+    }
+}
+
+void UHighLevelLearningSubsystem::ConfigureReplay(const FHighLevelReplayConfig& InConfig)
+{
+    WaitForReplayTask();
+
+    FScopeLock Lock(&TableLock);
+
+    ReplayConfig = InConfig;
+    ReplayConfig.BatchSize = FMath::Max(ReplayConfig.BatchSize, 1);
+    ReplayConfig.UpdateEveryTransitions = FMath::Max(ReplayConfig.UpdateEveryTransitions, 1);
+    TransitionsSinceUpdate = 0;
+
+    if (ReplayConfig.bEnabled)
+    {
+        // Уся пам'ять виділяється тут, далі буфер працює без алокацій
+        ReplayBuffer.Init(ReplayConfig.Capacity);
+        BatchScratch.Reserve(ReplayConfig.BatchSize);
+
+        if (!bSharedTableEnabled)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Experience replay needs the shared table - NPCs with own tables won't see replayed updates"));
+        }
+    }
+}
+
+bool UHighLevelLearningSubsystem::RecordTransition(const FHighLevelTransition& Transition, float LearningRate)
+{
+    if (!ReplayConfig.bEnabled && !PlanningConfig.bEnabled)
+    {
+        return false;
+    }
+
+    {
+        FScopeLock Lock(&TableLock);
+        
+        if (ReplayConfig.bEnabled)
+        {
+            ReplayBuffer.Add(Transition);
+            ReplayLearningRate = LearningRate;
+        }
+        
+        if (PlanningConfig.bEnabled)
+        {
+            DynaModel.Observe(SharedTable, Transition.State, Transition.Action, Transition.Reward, 
+                              Transition.NextState, Transition.Discount, PlanningConfig.PriorityThreshold);
+        }
+    }
+
+    if (!ReplayConfig.bEnabled ||
+        ++TransitionsSinceUpdate < ReplayConfig.UpdateEveryTransitions || 
+        ReplayBuffer.Num() < ReplayConfig.WarmupTransitions)
+    {
+        return false;
+    }
+    TransitionsSinceUpdate = 0;
+    return true;
+}
+
+void UHighLevelLearningSubsystem::AddTransition(const FHighLevelTransition& Transition, float LearningRate)
+{
+    if (!RecordTransition(Transition, LearningRate))
+    {
+        return;
+    }
+
+    if (!ReplayConfig.bBackgroundThread)
+    {
+        RunReplayBatch();
+        return;
+    }
+
+    // Попередній батч ще рахується - пропускаємо, а не ставимо в чергу
+    if (ReplayTask.IsValid() && !ReplayTask.IsReady())
+    {
+        return;
+    }
+
+    ReplayTask = Async(EAsyncExecution::ThreadPool, [this]()
+    {
+        RunReplayBatch();
+    });
+}
+
+void UHighLevelLearningSubsystem::RunReplayBatch()
+{
+    FScopeLock Lock(&TableLock);
+
+    ReplayBuffer.SampleBatch(Random, ReplayConfig.BatchSize, BatchScratch);
+    FHighLevelReplayBuffer::ApplyBatch(SharedTable, BatchScratch, ReplayLearningRate);
+    NumReplayUpdates += BatchScratch.Num();
+}
+
+void UHighLevelLearningSubsystem::ConfigurePlanning(const FHighLevelPlanningConfig& InConfig)
+{
+    StopPlanningThread();
+
+    {
+        FScopeLock Lock(&TableLock);
+        PlanningConfig = InConfig;
+        PlanningConfig.StepsPerLock = FMath::Max(PlanningConfig.StepsPerLock, 1);
+        DynaModel.Reset();
+    }
+
+    if (!PlanningConfig.bEnabled)
+    {
+        return;
+    }
+
+    if (!bSharedTableEnabled)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Dyna-Q planning needs the shared table - NPCs with own tables won't see planned updates"));
+    }
+
+    PlanningWorker = new FHighLevelPlanningWorker(this, FMath::Max(PlanningConfig.CycleIntervalMs, 1.0f) / 1000.0f);
+    PlanningThread = FRunnableThread::Create(PlanningWorker, TEXT("HighLevelPlanning"), 0, TPri_BelowNormal);
+}
+
+void UHighLevelLearningSubsystem::StopPlanningThread()
+{
+    if (PlanningThread)
+    {
+        // Kill(true) викликає Stop() і чекає завершення Run()
+        PlanningThread->Kill(true);
+        delete PlanningThread;
+        PlanningThread = nullptr;
+    }
+
+    delete PlanningWorker;
+    PlanningWorker = nullptr;
+}
+
+int32 UHighLevelLearningSubsystem::RunPlanningCycle()
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = PlanningConfig.BudgetMsPerCycle / 1000.0;
+    int32 TotalSteps = 0;
+
+    // Замок береться короткими порціями, щоб ігровий потік не чекав довше за кілька оновлень
+    while (FPlatformTime::Seconds() - StartTime < BudgetSeconds)
+    {
+        int32 Steps = 0;
+        {
+            FScopeLock Lock(&TableLock);
+            Steps = DynaModel.PlanSteps(SharedTable, PlanningConfig.StepsPerLock, PlanningConfig.LearningRate,
+                                        PlanningConfig.PriorityThreshold);
+        }
+
+        if (Steps == 0)
+        {
+            break;
+        }
+        TotalSteps += Steps;
+    }
+
+    NumPlanningUpdates += TotalSteps;
+    return TotalSteps;
+}
+
+FHighLevelDQN& UHighLevelLearningSubsystem::GetOrCreateDQN(const FHighLevelDQNConfig& Config)
+{
+    if (!SharedDQN)
+    {
+        SharedDQN = MakeUnique<FHighLevelDQN>(Config);
+
+        const FString FullPath = UQTableCacheSubsystem::GetTablePath(SharedDQN->GetFileName());
+        if (SharedDQN->LoadFromFile(FullPath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("✅ High-Level DQN loaded: %s"), *FullPath);
+        }
+    }
+    return *SharedDQN;
+}
+
+FHighLevelTileCoding& UHighLevelLearningSubsystem::GetOrCreateTileCoding(int32 NumTilings, int32 TilesPerNeed, int32 MemorySize)
+{
+    if (!SharedTileCoding)
+    {
+        SharedTileCoding = MakeUnique<FHighLevelTileCoding>(NumTilings, TilesPerNeed, MemorySize);
+
+        const FString FullPath = UQTableCacheSubsystem::GetTablePath(SharedTileCoding->GetFileName());
+        if (SharedTileCoding->LoadFromFile(FullPath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("✅ High-Level tile coding loaded: %s"), *FullPath);
+        }
+    }
+    return *SharedTileCoding;
+}
+
+FHighLevelSharedMemoryTable* UHighLevelLearningSubsystem::GetOrAttachSharedMemoryTable(const FString& RegionName)
+{
+    if (!SharedMemoryTable && !bSharedMemoryAttachFailed)
+    {
+        SharedMemoryTable = FHighLevelSharedMemoryTable::Attach(RegionName);
+        if (SharedMemoryTable)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("✅ Attached to shared Q-table %s: %lld updates, %d processes"),
+                   *RegionName, SharedMemoryTable->GetTotalUpdates(), SharedMemoryTable->GetNumAttached());
+        }
+        else
+        {
+            bSharedMemoryAttachFailed = true;
+            UE_LOG(LogTemp, Warning, TEXT("⚠️ Shared Q-table %s not found (is -run=QTableCoordinator running?), NPCs use the dense table"),
+                   *RegionName);
+        }
+    }
+    return SharedMemoryTable.Get();
+}
+
+void UHighLevelLearningSubsystem::ConfigureAsyncLearner(const FHighLevelAsyncLearnerConfig& InConfig)
+{
+    StopLearnerThread();
+
+    AsyncLearnerConfig = InConfig;
+    AsyncLearnerConfig.UpdatesPerLock = FMath::Max(AsyncLearnerConfig.UpdatesPerLock, 1);
+
+    if (!AsyncLearnerConfig.bEnabled)
+    {
+        return;
+    }
+
+    // Власні таблиці NPC і далі оновлюються синхронно
+    if (!bSharedTableEnabled)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Async high-level learner needs the shared table - NPCs keep updating their own tables"));
+        return;
+    }
+
+    // Перша копія - до першого рішення; якщо таблиця ще не завантажена, її опублікує EnsureSharedTableLoaded
+    if (bSharedTableLoaded)
+    {
+        FScopeLock Lock(&TableLock);
+        PublishedPolicy.Publish(SharedTable);
+    }
+    LastPublishTime = FPlatformTime::Seconds();
+
+    LearnerWorker = new FHighLevelLearnerWorker(this, (uint32)FMath::Max(FMath::CeilToInt(AsyncLearnerConfig.PublishIntervalMs), 1));
+    LearnerThread = FRunnableThread::Create(LearnerWorker, TEXT("HighLevelLearner"), 0, TPri_BelowNormal);
+}
+
+void UHighLevelLearningSubsystem::StopLearnerThread()
+{
+    if (!LearnerThread)
+    {
+        return;
+    }
+
+    LearnerThread->Kill(true);
+    delete LearnerThread;
+    LearnerThread = nullptr;
+
+    delete LearnerWorker;
+    LearnerWorker = nullptr;
+
+    // Те, що встигли поставити в чергу, не губимо
+    while (RunLearnerCycle() > 0)
+    {
+    }
+}
+
+void UHighLevelLearningSubsystem::EnqueueUpdate(const FHighLevelTransition& Transition, float LearningRate)
+{
+    FHighLevelQueuedUpdate Update;
+    Update.Transition = Transition;
+    Update.LearningRate = LearningRate;
+    PendingUpdates.Enqueue(Update);
+
+    if (LearnerWorker)
+    {
+        LearnerWorker->Wake();
+    }
+}
+
+void UHighLevelLearningSubsystem::RequestSave(const FString& FullPath)
+{
+    {
+        FScopeLock Lock(&SaveRequestLock);
+        PendingSavePath = FullPath;
+    }
+
+    if (LearnerWorker)
+    {
+        LearnerWorker->Wake();
+    }
+}
+
+bool UHighLevelLearningSubsystem::ApplyQueuedUpdate(const FHighLevelQueuedUpdate& Update)
+{
+    // Те саме правило, що й синхронне UHighLevelQLearning::UpdateQValue; Reward уже містить штраф за час
+    const FHighLevelTransition& Transition = Update.Transition;
+    const float CurrentQ = SharedTable.GetValue(Transition.State, Transition.Action);
+    const float MaxNextQ = SharedTable.GetMaxValue(Transition.NextState);
+    const float NewQ = CurrentQ + Update.LearningRate * (Transition.Reward + Transition.Discount * MaxNextQ - CurrentQ);
+
+    SharedTable.SetValue(Transition.State, Transition.Action, NewQ);
+    NumAsyncUpdates++;
+
+    return RecordTransition(Transition, Update.LearningRate);
+}
+
+int32 UHighLevelLearningSubsystem::RunLearnerCycle()
+{
+    // Запит знімаємо до розбору черги: усе, що NPC поставив до запиту, потрапить у файл
+    FString SavePath;
+    {
+        FScopeLock Lock(&SaveRequestLock);
+        Swap(SavePath, PendingSavePath);
+    }
+
+    int32 NumApplied = 0;
+    for (;;)
+    {
+        int32 Steps = 0;
+        bool bReplayDue = false;
+        {
+            FScopeLock Lock(&TableLock);
+            FHighLevelQueuedUpdate Update;
+            while (Steps < AsyncLearnerConfig.UpdatesPerLock && PendingUpdates.Dequeue(Update))
+            {
+                bReplayDue |= ApplyQueuedUpdate(Update);
+                Steps++;
+            }
+        }
+
+        // Повтори - тут же, в потоці учня, і вже без замка: пул потоків не чекає на таблицю
+        if (bReplayDue)
+        {
+            RunReplayBatch();
+        }
+
+        NumApplied += Steps;
+        if (Steps < AsyncLearnerConfig.UpdatesPerLock)
+        {
+            break;
+        }
+    }
+
+    // Копія публікується і без нових оновлень - планування теж змінює таблицю
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastPublishTime >= AsyncLearnerConfig.PublishIntervalMs / 1000.0)
+    {
+        FScopeLock Lock(&TableLock);
+        PublishedPolicy.Publish(SharedTable);
+        LastPublishTime = Now;
+    }
+
+    if (!SavePath.IsEmpty())
+    {
+        FScopeLock Lock(&TableLock);
+        SharedTable.SaveToFile(SavePath);
+        UE_LOG(LogTemp, Log, TEXT("High-Level Q-Table saved by async learner: %d states, %lld async updates, Path: %s"),
+               SharedTable.GetNumStoredStates(), NumAsyncUpdates.load(), *SavePath);
+    }
+
+    return NumApplied;
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Core/HighLevelQTable.h"
+#include "../Core/HighLevelReplayBuffer.h"
+#include "../Core/HighLevelDynaModel.h"
+#include "../Core/HighLevelDQN.h"
+#include "../Core/HighLevelTileCoding.h"
+#include "../Core/HighLevelPublishedPolicy.h"
+#include "../Core/HighLevelSharedMemoryTable.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
+#include <atomic>
+#include "HighLevelLearningSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FHighLevelReplayConfig
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bEnabled = false;
+
+    // Переходів у кільцевому буфері (по 24 байти)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Capacity = 50000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 BatchSize = 32;
+
+    // Мінібатч після кожних N нових переходів
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 UpdateEveryTransitions = 4;
+
+    // Скільки переходів накопичити, перш ніж почати повтори
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 WarmupTransitions = 256;
+
+    // Мінібатчі в пулі потоків замість ігрового потоку
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bBackgroundThread = false;
+};
+
+USTRUCT(BlueprintType)
+struct FHighLevelPlanningConfig
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bEnabled = false;
+
+    // Скільки мілісекунд планування за цикл робочого потоку
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float BudgetMsPerCycle = 1.0f;
+
+    // Пауза між циклами; BudgetMsPerCycle / CycleIntervalMs - частка одного ядра
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float CycleIntervalMs = 16.0f;
+
+    // Оновлень за одне захоплення замка таблиці
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 StepsPerLock = 16;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float PriorityThreshold = 0.5f;
+
+    // Дисконт береться з переходу - той самий, що в онлайн-оновленні
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float LearningRate = 0.1f;
+};
+
+USTRUCT(BlueprintType)
+struct FHighLevelAsyncLearnerConfig
+{
+    GENERATED_BODY()
+
+    // Ігровий потік тільки ставить переходи в чергу; TD-оновлення, повтори і збереження - в потоці учня,
+    // рішення NPC читають опубліковану копію таблиці. Тільки для спільної таблиці без слідів придатності.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bEnabled = false;
+
+    // Як часто потік учня публікує копію таблиці для рішень
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float PublishIntervalMs = 100.0f;
+
+    // Оновлень за одне захоплення замка таблиці - планування не чекає довше
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 UpdatesPerLock = 64;
+};
+
+// Онлайн-оновлення, яке ігровий потік передає потоку учня
+struct FHighLevelQueuedUpdate
+{
+    FHighLevelTransition Transition;
+    float LearningRate = 0.0f;
+};
+
+// Спільна для всіх NPC високорівнева таблиця і буфер повторного досвіду.
+// Таблиця завантажується один раз при створенні світу і зберігається NPC при смерті, як і раніше.
+// Опційно - Dyna-Q: модель переходів і планування в окремому потоці;
+// асинхронний учень: онлайн-оновлення в окремому потоці, рішення - з опублікованої копії.
+UCLASS()
+class QLEARNING_API UHighLevelLearningSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // Таблиця читається при першому зверненні, а не в Initialize: кукнутий ассет встигає довантажитися
+    // разом з рівнем, а світ лише із замороженою політикою її не вантажить
+    FHighLevelQTable& GetSharedTable();
+
+    // Захищає SharedTable і буфер, коли повтори йдуть у фоні
+    FCriticalSection& GetTableLock() { return TableLock; }
+
+    void SetSharedTableEnabled(bool bEnabled) { bSharedTableEnabled = bEnabled; }
+    bool IsSharedTableEnabled() const { return bSharedTableEnabled; }
+
+    void ConfigureReplay(const FHighLevelReplayConfig& InConfig);
+    const FHighLevelReplayConfig& GetReplayConfig() const { return ReplayConfig; }
+
+    // Викликається з UHighLevelQLearning після кожного онлайн-оновлення.
+    // Повтори йдуть з тим самим кроком навчання і дисконтом, що й онлайн-оновлення
+    void AddTransition(const FHighLevelTransition& Transition, float LearningRate);
+
+    int64 GetNumReplayUpdates() const { return NumReplayUpdates; }
+
+    // Глобальний лічильник онлайн-оновлень усіх NPC (з урахуванням завантаженої таблиці) -
+    // за ним спадають графіки дослідження
+    void NotifyOnlineUpdate() { NumOnlineUpdates++; }
+    int64 GetNumOnlineUpdates() const { return NumOnlineUpdates; }
+    // NPC з власною таблицею чи апроксиматором повідомляє, скільки оновлень уже в завантаженому
+    void SeedOnlineUpdates(int64 LoadedUpdates) { NumOnlineUpdates = FMath::Max(NumOnlineUpdates, LoadedUpdates); }
+
+    void ConfigurePlanning(const FHighLevelPlanningConfig& InConfig);
+    const FHighLevelPlanningConfig& GetPlanningConfig() const { return PlanningConfig; }
+    int64 GetNumPlanningUpdates() const { return NumPlanningUpdates.load(); }
+
+    // Один цикл планування в межах бюджету; викликається робочим потоком
+    int32 RunPlanningCycle();
+
+    void ConfigureAsyncLearner(const FHighLevelAsyncLearnerConfig& InConfig);
+    const FHighLevelAsyncLearnerConfig& GetAsyncLearnerConfig() const { return AsyncLearnerConfig; }
+    bool IsAsyncLearnerRunning() const { return LearnerThread != nullptr; }
+    int64 GetNumAsyncUpdates() const { return NumAsyncUpdates.load(); }
+
+    // Ігровий потік: без замків, тільки вузол у MPSC-черзі
+    void EnqueueUpdate(const FHighLevelTransition& Transition, float LearningRate);
+
+    // Потік учня збереже таблицю після наступного циклу
+    void RequestSave(const FString& FullPath);
+
+    // Копія спільної таблиці для рішень при увімкненому асинхронному учні
+    const FHighLevelPublishedPolicy& GetPublishedPolicy() const { return PublishedPolicy; }
+
+    // Один цикл потоку учня: розібрати чергу, опублікувати копію, зберегти на запит.
+    // Повертає кількість застосованих оновлень
+    int32 RunLearnerCycle();
+
+    // Спільна Q-мережа; створюється і завантажується з файлу першим NPC з DQN-бекендом
+    FHighLevelDQN& GetOrCreateDQN(const FHighLevelDQNConfig& Config);
+
+    // Спільні ваги tile coding - так само одні на світ і один файл
+    FHighLevelTileCoding& GetOrCreateTileCoding(int32 NumTilings, int32 TilesPerNeed, int32 MemorySize);
+
+    // Таблиця координатора в спільній пам'яті; nullptr, якщо регіону ще немає
+    FHighLevelSharedMemoryTable* GetOrAttachSharedMemoryTable(const FString& RegionName);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void RunReplayBatch();
+    void WaitForReplayTask();
+    void StopPlanningThread();
+    void StopLearnerThread();
+    void EnsureSharedTableLoaded();
+    // Повертає true, коли настав час для батча повторів
+    bool ApplyQueuedUpdate(const FHighLevelQueuedUpdate& Update);
+    bool RecordTransition(const FHighLevelTransition& Transition, float LearningRate);
+
+    FHighLevelQTable SharedTable;
+    FCriticalSection TableLock;
+    bool bSharedTableEnabled = true;
+    bool bSharedTableLoaded = false;
+
+    FHighLevelReplayConfig ReplayConfig;
+    FHighLevelReplayBuffer ReplayBuffer;
+    TArray<const FHighLevelTransition*> BatchScratch;
+    FRandomStream Random;
+    int32 TransitionsSinceUpdate = 0;
+    float ReplayLearningRate = 0.1f;
+    int64 NumReplayUpdates = 0;
+    int64 NumOnlineUpdates = 0;
+
+    TFuture<void> ReplayTask;
+
+    FHighLevelPlanningConfig PlanningConfig;
+    FHighLevelDynaModel DynaModel;
+    std::atomic<int64> NumPlanningUpdates{0};
+
+    TUniquePtr<FHighLevelDQN> SharedDQN;
+    TUniquePtr<FHighLevelTileCoding> SharedTileCoding;
+    TUniquePtr<FHighLevelSharedMemoryTable> SharedMemoryTable;
+    // Без координатора не під'єднуємось повторно для кожного NPC цього світу
+    bool bSharedMemoryAttachFailed = false;
+
+    class FHighLevelPlanningWorker* PlanningWorker = nullptr;
+    class FRunnableThread* PlanningThread = nullptr;
+
+    FHighLevelAsyncLearnerConfig AsyncLearnerConfig;
+    TQueue<FHighLevelQueuedUpdate, EQueueMode::Mpsc> PendingUpdates;
+    FHighLevelPublishedPolicy PublishedPolicy;
+    double LastPublishTime = 0.0;
+    std::atomic<int64> NumAsyncUpdates{0};
+
+    FCriticalSection SaveRequestLock;
+    FString PendingSavePath;
+
+    class FHighLevelLearnerWorker* LearnerWorker = nullptr;
+    class FRunnableThread* LearnerThread = nullptr;
+};
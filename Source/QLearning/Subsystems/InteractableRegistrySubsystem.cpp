@@ -0,0 +1,88 @@
+#include "InteractableRegistrySubsystem.h"
+#include "../Actors/InteractableObject.h"
+#include "EngineUtils.h"
+
+bool UInteractableRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInteractableRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Заповнюємо реєстр до BeginPlay акторів, щоб перші NPC не залежали від порядку BeginPlay
+    for (TActorIterator<AInteractableObject> It(&InWorld); It; ++It)
+    {
+        RegisterInteractable(*It);
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("Interactable registry ready: %d objects"), Interactables.Num());
+}
+
+void UInteractableRegistrySubsystem::Deinitialize()
+{
+    for (AInteractableObject* Object : Interactables)
+    {
+        if (IsValid(Object))
+        {
+            Object->OnOccupancyChanged.RemoveAll(this);
+        }
+    }
+    Interactables.Empty();
+    for (TArray<AInteractableObject*>& ByAction : InteractablesByAction)
+    {
+        ByAction.Empty();
+    }
+    SpatialIndex.Reset();
+
+    Super::Deinitialize();
+}
+
+void UInteractableRegistrySubsystem::RegisterInteractable(AInteractableObject* Object)
+{
+    if (!Object || Object->ActionType >= EActionType::MAX || SpatialIndex.Contains(Object))
+    {
+        return;
+    }
+
+    Interactables.Add(Object);
+    InteractablesByAction[(int32)Object->ActionType].Add(Object);
+    SpatialIndex.Add(Object);
+    Object->OnOccupancyChanged.AddUObject(this, &UInteractableRegistrySubsystem::HandleOccupancyChanged);
+
+    UE_LOG(LogTemp, Log, TEXT("Registered interactable %s (%d total)"), *Object->GetName(), Interactables.Num());
+
+    OnInteractableRegistered.Broadcast(Object);
+}
+
+void UInteractableRegistrySubsystem::UnregisterInteractable(AInteractableObject* Object)
+{
+    if (!Object || !SpatialIndex.Contains(Object))
+    {
+        return;
+    }
+
+    Object->OnOccupancyChanged.RemoveAll(this);
+    SpatialIndex.Remove(Object);
+    Interactables.RemoveSingleSwap(Object);
+    InteractablesByAction[(int32)Object->ActionType].RemoveSingleSwap(Object);
+
+    OnInteractableUnregistered.Broadcast(Object);
+}
+
+void UInteractableRegistrySubsystem::HandleOccupancyChanged(AInteractableObject* Object, bool bFree)
+{
+    SpatialIndex.SetFree(Object, bFree);
+    
+    if (bFree)
+    {
+        OnInteractableFreed.Broadcast(Object);
+    }
+}
+
+AInteractableObject* UInteractableRegistrySubsystem::FindNearestFree(EActionType ActionType, const FVector& Location,
+                                                                     float* OutDistSquared) const
+{
+    return SpatialIndex.FindNearestFree(ActionType, Location, OutDistSquared);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Actors/InteractableSpatialIndex.h"
+#include "InteractableRegistrySubsystem.generated.h"
+
+class AInteractableObject;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInteractableRegistryChanged, AInteractableObject*);
+
+// Єдиний реєстр інтерактивних об'єктів світу. Об'єкти реєструються самі в BeginPlay/EndPlay,
+// тож NPC не сканують світ і не тримають власних копій списку.
+UCLASS()
+class QLEARNING_API UInteractableRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    void RegisterInteractable(AInteractableObject* Object);
+    void UnregisterInteractable(AInteractableObject* Object);
+
+    AInteractableObject* FindNearestFree(EActionType ActionType, const FVector& Location,
+                                         float* OutDistSquared = nullptr) const;
+
+    int32 NumFree(EActionType ActionType) const { return SpatialIndex.NumFree(ActionType); }
+    const TArray<AInteractableObject*>& GetInteractables() const { return Interactables; }
+    const TArray<AInteractableObject*>& GetInteractables(EActionType ActionType) const { return InteractablesByAction[(int32)ActionType]; }
+
+    FOnInteractableRegistryChanged OnInteractableRegistered;
+    FOnInteractableRegistryChanged OnInteractableUnregistered;
+    FOnInteractableRegistryChanged OnInteractableFreed;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void HandleOccupancyChanged(AInteractableObject* Object, bool bFree);
+
+    UPROPERTY()
+    TArray<AInteractableObject*> Interactables;
+
+    // Ті самі об'єкти по типах дії; від GC їх тримає Interactables
+    TArray<AInteractableObject*> InteractablesByAction[(int32)EActionType::MAX];
+
+    FInteractableSpatialIndex SpatialIndex;
+};
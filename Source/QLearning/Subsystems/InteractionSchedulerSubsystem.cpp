@@ -0,0 +1,76 @@
+#include "InteractionSchedulerSubsystem.h"
+#include "../Actors/InteractableObject.h"
+
+bool UInteractionSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UInteractionSchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UInteractionSchedulerSubsystem::Deinitialize()
+{
+    Pending.Empty();
+
+    Super::Deinitialize();
+}
+
+uint32 UInteractionSchedulerSubsystem::Schedule(AInteractableObject* Object, float Duration)
+{
+    return Push(Object, Duration, false);
+}
+
+uint32 UInteractionSchedulerSubsystem::ScheduleReservationTimeout(AInteractableObject* Object, float Duration)
+{
+    return Push(Object, Duration, true);
+}
+
+uint32 UInteractionSchedulerSubsystem::Push(AInteractableObject* Object, float Duration, bool bReservationTimeout)
+{
+    // 0 означає "нічого не заплановано"
+    if (NextSerial == 0)
+    {
+        NextSerial = 1;
+    }
+
+    FScheduledCompletion Completion;
+    Completion.CompletionTime = GetWorld()->GetTimeSeconds() + FMath::Max(Duration, 0.0f);
+    Completion.Object = Object;
+    Completion.Serial = NextSerial++;
+    Completion.bReservationTimeout = bReservationTimeout;
+
+    Pending.HeapPush(Completion);
+    return Completion.Serial;
+}
+
+void UInteractionSchedulerSubsystem::Tick(float DeltaTime)
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    while (Pending.Num() > 0 && Pending.HeapTop().CompletionTime <= Now)
+    {
+        FScheduledCompletion Completion;
+        Pending.HeapPop(Completion, EAllowShrinking::No);
+
+        AInteractableObject* Object = Completion.Object.Get();
+        if (!Object)
+        {
+            continue;
+        }
+
+        if (Completion.bReservationTimeout)
+        {
+            if (Object->GetReservationSerial() == Completion.Serial)
+            {
+                Object->ExpireReservation();
+            }
+        }
+        else if (Object->GetScheduledSerial() == Completion.Serial)
+        {
+            Object->CompleteInteraction();
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InteractionSchedulerSubsystem.generated.h"
+
+class AInteractableObject;
+
+// Єдина мін-купа завершень взаємодій і таймаутів резервувань замість окремих FTimerHandle на кожен об'єкт.
+// Скасування ліниве: об'єкт скидає свій серійний номер, і застарілий запис просто відкидається.
+UCLASS()
+class QLEARNING_API UInteractionSchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Повертає серійний номер, який об'єкт зберігає до завершення
+    uint32 Schedule(AInteractableObject* Object, float Duration);
+    uint32 ScheduleReservationTimeout(AInteractableObject* Object, float Duration);
+
+    int32 GetNumScheduled() const { return Pending.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FScheduledCompletion
+    {
+        double CompletionTime = 0.0;
+        TWeakObjectPtr<AInteractableObject> Object;
+        uint32 Serial = 0;
+        bool bReservationTimeout = false;
+
+        bool operator<(const FScheduledCompletion& Other) const { return CompletionTime < Other.CompletionTime; }
+    };
+
+    uint32 Push(AInteractableObject* Object, float Duration, bool bReservationTimeout);
+
+    TArray<FScheduledCompletion> Pending;
+    uint32 NextSerial = 1;
+};
@@ -0,0 +1,356 @@
+#include "NPCDecisionSubsystem.h"
+#include "InteractableRegistrySubsystem.h"
+#include "../Actors/InteractableObject.h"
+#include "../Characters/NPCCharacter.h"
+#include "../Components/NeedsComponent.h"
+#include "../Components/HighLevelQLearning.h"
+
+namespace
+{
+    float GetDecisionPriorityNeed(const ANPCCharacter* NPC)
+    {
+        return NPC->NeedsComponent ?
+            NPC->NeedsComponent->GetNeedValue(NPC->NeedsComponent->GetMostCriticalNeed()) : 100.0f;
+    }
+}
+
+void UNPCDecisionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UInteractableRegistrySubsystem* Registry = Collection.InitializeDependency<UInteractableRegistrySubsystem>())
+    {
+        Registry->OnInteractableRegistered.AddUObject(this, &UNPCDecisionSubsystem::HandleObjectAvailable);
+        Registry->OnInteractableFreed.AddUObject(this, &UNPCDecisionSubsystem::HandleObjectAvailable);
+    }
+}
+
+void UNPCDecisionSubsystem::Deinitialize()
+{
+    if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+    {
+        Registry->OnInteractableRegistered.RemoveAll(this);
+        Registry->OnInteractableFreed.RemoveAll(this);
+    }
+
+    LogLatencyStats();
+
+    ReadyQueue.Empty();
+    DeferredRequests.Empty();
+    DelayedRequests.Empty();
+    QueuedNPCs.Empty();
+    WaitingNPCs.Empty();
+    for (TArray<TWeakObjectPtr<ANPCCharacter>>& Waiting : WaitingByAction)
+    {
+        Waiting.Empty();
+    }
+
+    Super::Deinitialize();
+}
+
+bool UNPCDecisionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNPCDecisionSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UNPCDecisionSubsystem, STATGROUP_Tickables);
+}
+
+void UNPCDecisionSubsystem::RequestDecision(ANPCCharacter* NPC)
+{
+    if (!NPC || QueuedNPCs.Contains(NPC))
+    {
+        return;
+    }
+
+    StopWaiting(NPC);
+    RemoveDelayedRequest(NPC);
+
+    FDecisionRequest Request;
+    Request.NPC = NPC;
+    Request.EnqueueTime = FPlatformTime::Seconds();
+    Request.LowestNeed = GetDecisionPriorityNeed(NPC);
+
+    QueuedNPCs.Add(NPC);
+
+    // Запити, що з'являться під час обробки, підуть на наступний тік
+    if (bIsProcessing)
+    {
+        DeferredRequests.Add(Request);
+    }
+    else
+    {
+        ReadyQueue.HeapPush(Request);
+    }
+}
+
+void UNPCDecisionSubsystem::RequestDecisionAfter(ANPCCharacter* NPC, float DelaySeconds)
+{
+    if (!NPC || QueuedNPCs.Contains(NPC))
+    {
+        return;
+    }
+
+    if (DelaySeconds <= 0.0f)
+    {
+        RequestDecision(NPC);
+        return;
+    }
+
+    StopWaiting(NPC);
+    RemoveDelayedRequest(NPC);
+
+    FDelayedRequest& Delayed = DelayedRequests.AddDefaulted_GetRef();
+    Delayed.NPC = NPC;
+    Delayed.DueTime = FPlatformTime::Seconds() + DelaySeconds;
+}
+
+void UNPCDecisionSubsystem::WaitForObject(ANPCCharacter* NPC, EActionType ActionType)
+{
+    if (!NPC || ActionType >= EActionType::MAX)
+    {
+        return;
+    }
+
+    // Повторне очікування не лишає NPC у списку попереднього типу
+    StopWaiting(NPC);
+    RemoveDelayedRequest(NPC);
+
+    WaitingNPCs.Add(NPC, ActionType);
+    WaitingByAction[(int32)ActionType].Add(NPC);
+}
+
+void UNPCDecisionSubsystem::CancelDecision(ANPCCharacter* NPC)
+{
+    QueuedNPCs.Remove(NPC);
+    StopWaiting(NPC);
+    RemoveDelayedRequest(NPC);
+}
+
+void UNPCDecisionSubsystem::StopWaiting(const ANPCCharacter* NPC)
+{
+    EActionType ActionType;
+    if (!WaitingNPCs.RemoveAndCopyValue(NPC, ActionType))
+    {
+        return;
+    }
+
+    // Порядок зберігаємо - першим прокидається той, хто чекає найдовше
+    TArray<TWeakObjectPtr<ANPCCharacter>>& Waiting = WaitingByAction[(int32)ActionType];
+    const int32 Index = Waiting.IndexOfByPredicate([NPC](const TWeakObjectPtr<ANPCCharacter>& WeakNPC)
+    {
+        return WeakNPC.Get() == NPC;
+    });
+    if (Index != INDEX_NONE)
+    {
+        Waiting.RemoveAt(Index, EAllowShrinking::No);
+    }
+}
+
+void UNPCDecisionSubsystem::RemoveDelayedRequest(const ANPCCharacter* NPC)
+{
+    const int32 Index = DelayedRequests.IndexOfByPredicate([NPC](const FDelayedRequest& Delayed)
+    {
+        return Delayed.NPC.Get() == NPC;
+    });
+    if (Index != INDEX_NONE)
+    {
+        DelayedRequests.RemoveAtSwap(Index, EAllowShrinking::No);
+    }
+}
+
+void UNPCDecisionSubsystem::FlushDueDelayedRequests()
+{
+    const double Now = FPlatformTime::Seconds();
+    for (int32 i = DelayedRequests.Num() - 1; i >= 0; i--)
+    {
+        if (DelayedRequests[i].DueTime > Now)
+        {
+            continue;
+        }
+
+        ANPCCharacter* NPC = DelayedRequests[i].NPC.Get();
+        DelayedRequests.RemoveAtSwap(i, EAllowShrinking::No);
+        if (NPC)
+        {
+            RequestDecision(NPC);
+        }
+    }
+}
+
+void UNPCDecisionSubsystem::HandleObjectAvailable(AInteractableObject* Object)
+{
+    if (!Object || Object->ActionType >= EActionType::MAX)
+    {
+        return;
+    }
+
+    // Один об'єкт - один NPC: решта чекає на наступне звільнення, а не б'ється за цей
+    TArray<TWeakObjectPtr<ANPCCharacter>>& Waiting = WaitingByAction[(int32)Object->ActionType];
+    while (Waiting.Num() > 0)
+    {
+        ANPCCharacter* NPC = Waiting[0].Get();
+        if (!NPC)
+        {
+            Waiting.RemoveAt(0, EAllowShrinking::No);
+            continue;
+        }
+
+        RequestDecision(NPC);
+        break;
+    }
+}
+
+void UNPCDecisionSubsystem::Tick(float DeltaTime)
+{
+    if (DelayedRequests.Num() > 0)
+    {
+        FlushDueDelayedRequests();
+    }
+
+    if (ReadyQueue.Num() == 0)
+    {
+        return;
+    }
+
+    LatencyStats.MaxQueueLength = FMath::Max(LatencyStats.MaxQueueLength, ReadyQueue.Num());
+
+    // Потреби падають, поки NPC стоїть у черзі - пріоритети з моменту запиту застарівають
+    for (FDecisionRequest& Request : ReadyQueue)
+    {
+        if (const ANPCCharacter* NPC = Request.NPC.Get())
+        {
+            Request.LowestNeed = GetDecisionPriorityNeed(NPC);
+        }
+    }
+    ReadyQueue.Heapify();
+
+    const double StartTime = FPlatformTime::Seconds();
+    double Now = StartTime;
+    bIsProcessing = true;
+
+    // Хоча б одне рішення за кадр, решта - поки є бюджет
+    int32 NumProcessed = 0;
+    while (ReadyQueue.Num() > 0 && (NumProcessed == 0 || Now - StartTime < FrameBudgetSeconds))
+    {
+        // NPC лишаються в QueuedNPCs до самого рішення, тож CancelDecision діє і всередині пакета
+        DecisionBatch.Reset();
+        while (ReadyQueue.Num() > 0 && DecisionBatch.Num() < InferenceBatchSize)
+        {
+            FDecisionRequest Request;
+            ReadyQueue.HeapPop(Request, EAllowShrinking::No);
+
+            ANPCCharacter* NPC = Request.NPC.Get();
+            if (NPC && QueuedNPCs.Contains(NPC))
+            {
+                DecisionBatch.Add(Request);
+            }
+        }
+
+        if (DecisionBatch.Num() > 1)
+        {
+            PrefetchBatchValues();
+        }
+
+        for (int32 i = 0; i < DecisionBatch.Num(); i++)
+        {
+            const FDecisionRequest& Request = DecisionBatch[i];
+            ANPCCharacter* NPC = Request.NPC.Get();
+
+            if (NumProcessed > 0 && Now - StartTime >= FrameBudgetSeconds)
+            {
+                // Бюджет вичерпано - решта пакета повертається в чергу
+                if (NPC && NPC->HighLevelQL)
+                {
+                    NPC->HighLevelQL->ClearPrefetchedValues();
+                }
+                ReadyQueue.HeapPush(Request);
+                continue;
+            }
+
+            if (!NPC || QueuedNPCs.Remove(NPC) == 0)
+            {
+                continue;
+            }
+
+            const double QueueSeconds = Now - Request.EnqueueTime;
+            LatencyStats.NumDecisions++;
+            LatencyStats.TotalQueueSeconds += QueueSeconds;
+            LatencyStats.MaxQueueSeconds = FMath::Max(LatencyStats.MaxQueueSeconds, QueueSeconds);
+
+            NPC->MakeDecision();
+
+            if (NPC->HighLevelQL)
+            {
+                NPC->HighLevelQL->ClearPrefetchedValues();
+            }
+
+            NumProcessed++;
+            Now = FPlatformTime::Seconds();
+        }
+    }
+
+    bIsProcessing = false;
+
+    if (ReadyQueue.Num() > 0)
+    {
+        LatencyStats.NumFramesOverBudget++;
+    }
+
+    for (const FDecisionRequest& Request : DeferredRequests)
+    {
+        ReadyQueue.HeapPush(Request);
+    }
+    DeferredRequests.Reset();
+}
+
+void UNPCDecisionSubsystem::PrefetchBatchValues()
+{
+    const int32 NumObservations = FHighLevelValueBackend::NumObservations;
+    const int32 NumActions = FHighLevelValueBackend::NumActions;
+
+    // Пакетом рахується тільки спільна мережа; таблиця і власні копії NPC - як раніше, по одному
+    const FHighLevelValueBackend* Backend = nullptr;
+    BatchLearners.Reset();
+    BatchObservations.Reset();
+    BatchStates.Reset();
+
+    for (const FDecisionRequest& Request : DecisionBatch)
+    {
+        ANPCCharacter* NPC = Request.NPC.Get();
+        UHighLevelQLearning* Learner = NPC ? NPC->HighLevelQL : nullptr;
+        if (!Learner || !Learner->UsesSharedValueBackend() || (Backend && Learner->GetValueBackend() != Backend))
+        {
+            continue;
+        }
+
+        Backend = Learner->GetValueBackend();
+        // Стан віддається NPC разом зі значеннями - MakeDecision не збиратиме його вдруге
+        const FHighLevelState& State = BatchStates.Add_GetRef(Learner->GetCurrentState());
+        BatchObservations.Append(State.Observation, NumObservations);
+        BatchLearners.Add(Learner);
+    }
+
+    if (BatchLearners.Num() < 2)
+    {
+        return;
+    }
+
+    BatchValues.SetNumUninitialized(BatchLearners.Num() * NumActions, EAllowShrinking::No);
+    Backend->EvaluateBatch(BatchObservations.GetData(), BatchLearners.Num(), BatchValues.GetData());
+
+    for (int32 i = 0; i < BatchLearners.Num(); i++)
+    {
+        BatchLearners[i]->SetPrefetchedValues(MoveTemp(BatchStates[i]), &BatchValues[i * NumActions]);
+    }
+}
+
+void UNPCDecisionSubsystem::LogLatencyStats() const
+{
+    UE_LOG(LogTemp, Warning, TEXT("=== DECISION SCHEDULER: %d decisions, queue delay avg %.2f ms / max %.2f ms, max queue %d, %d frames over %.2f ms budget ==="),
+           LatencyStats.NumDecisions, LatencyStats.GetAverageQueueSeconds() * 1000.0,
+           LatencyStats.MaxQueueSeconds * 1000.0, LatencyStats.MaxQueueLength,
+           LatencyStats.NumFramesOverBudget, GetFrameBudgetMs());
+}
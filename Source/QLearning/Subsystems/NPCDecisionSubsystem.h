@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Core/QLearningTypes.h"
+#include "../Components/HighLevelQLearning.h"
+#include "NPCDecisionSubsystem.generated.h"
+
+class ANPCCharacter;
+class AInteractableObject;
+
+struct FDecisionLatencyStats
+{
+    int32 NumDecisions = 0;
+    int32 MaxQueueLength = 0;
+    int32 NumFramesOverBudget = 0;
+    double TotalQueueSeconds = 0.0;
+    double MaxQueueSeconds = 0.0;
+
+    double GetAverageQueueSeconds() const { return NumDecisions > 0 ? TotalQueueSeconds / NumDecisions : 0.0; }
+};
+
+// Центральна черга готових до рішення NPC. Рішення запускаються подіями
+// (завершення/провал макро-дії, перетин рівня потреби, звільнення об'єкта), а не таймерами.
+// За кадр обробляється стільки NPC, скільки влазить у бюджет часу, першими - з найкритичнішою потребою.
+UCLASS()
+class QLEARNING_API UNPCDecisionSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // NPC буде оброблено на одному з наступних тіків
+    void RequestDecision(ANPCCharacter* NPC);
+
+    // Те саме, але не раніше ніж через DelaySeconds (пауза після провалу макро-дії)
+    void RequestDecisionAfter(ANPCCharacter* NPC, float DelaySeconds);
+
+    // Немає вільного об'єкта потрібного типу - NPC чекає, поки такий звільниться
+    void WaitForObject(ANPCCharacter* NPC, EActionType ActionType);
+
+    void CancelDecision(ANPCCharacter* NPC);
+
+    bool IsWaiting(const ANPCCharacter* NPC) const { return WaitingNPCs.Contains(NPC); }
+    int32 GetNumReady() const { return ReadyQueue.Num(); }
+
+    void SetFrameBudgetMs(float InBudgetMs) { FrameBudgetSeconds = FMath::Max(0.0f, InBudgetMs) / 1000.0; }
+    float GetFrameBudgetMs() const { return (float)(FrameBudgetSeconds * 1000.0); }
+
+    // Скільки NPC знімати з черги разом: Q спільної мережі для них рахуються одним пакетом
+    void SetInferenceBatchSize(int32 InBatchSize) { InferenceBatchSize = FMath::Max(InBatchSize, 1); }
+
+    const FDecisionLatencyStats& GetLatencyStats() const { return LatencyStats; }
+    void ResetLatencyStats() { LatencyStats = FDecisionLatencyStats(); }
+    void LogLatencyStats() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FDecisionRequest
+    {
+        TWeakObjectPtr<ANPCCharacter> NPC;
+        float LowestNeed = 0.0f;
+        double EnqueueTime = 0.0;
+
+        bool operator<(const FDecisionRequest& Other) const { return LowestNeed < Other.LowestNeed; }
+    };
+
+    struct FDelayedRequest
+    {
+        TWeakObjectPtr<ANPCCharacter> NPC;
+        double DueTime = 0.0;
+    };
+
+    void HandleObjectAvailable(AInteractableObject* Object);
+    void StopWaiting(const ANPCCharacter* NPC);
+    void RemoveDelayedRequest(const ANPCCharacter* NPC);
+    void FlushDueDelayedRequests();
+    void PrefetchBatchValues();
+
+    // Мін-купа за найнижчою потребою
+    TArray<FDecisionRequest> ReadyQueue;
+    TArray<FDecisionRequest> DeferredRequests;
+    TArray<FDelayedRequest> DelayedRequests;
+    TSet<const ANPCCharacter*> QueuedNPCs;
+    bool bIsProcessing = false;
+
+    double FrameBudgetSeconds = 0.0005;
+    FDecisionLatencyStats LatencyStats;
+
+    int32 InferenceBatchSize = 1;
+    TArray<FDecisionRequest> DecisionBatch;
+    TArray<class UHighLevelQLearning*> BatchLearners;
+    TArray<float> BatchObservations;
+    TArray<FHighLevelState> BatchStates;
+    TArray<float> BatchValues;
+
+    TArray<TWeakObjectPtr<ANPCCharacter>> WaitingByAction[(int32)EActionType::MAX];
+    TMap<const ANPCCharacter*, EActionType> WaitingNPCs;
+};
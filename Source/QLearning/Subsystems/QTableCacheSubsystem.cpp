@@ -0,0 +1,161 @@
+#include "QTableCacheSubsystem.h"
+#include "../Core/HighLevelQTableAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/Paths.h"
+
+bool UQTableCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UQTableCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Поки вантажиться рівень, кукнута таблиця вже в дорозі
+    RequestAsset(GetTableAssetId(TEXT("HighLevelQTable.json")));
+}
+
+void UQTableCacheSubsystem::Deinitialize()
+{
+    Tables.Empty();
+
+    if (UAssetManager::IsInitialized())
+    {
+        for (const TPair<FPrimaryAssetId, TSharedPtr<FStreamableHandle>>& Pair : AssetHandles)
+        {
+            if (Pair.Value)
+            {
+                UAssetManager::Get().UnloadPrimaryAsset(Pair.Key);
+            }
+        }
+    }
+    AssetHandles.Empty();
+    ReadyCallbacks.Empty();
+
+    Super::Deinitialize();
+}
+
+FString UQTableCacheSubsystem::GetTablePath(const FString& Filename)
+{
+    return FPaths::ProjectSavedDir() + TEXT("QLearning/") + Filename;
+}
+
+FPrimaryAssetId UQTableCacheSubsystem::GetTableAssetId(const FString& Filename)
+{
+    return FPrimaryAssetId(UHighLevelQTableAsset::AssetType, FName(*FPaths::GetBaseFilename(Filename)));
+}
+
+TSharedPtr<FStreamableHandle> UQTableCacheSubsystem::RequestAsset(const FPrimaryAssetId& AssetId)
+{
+    if (const TSharedPtr<FStreamableHandle>* Existing = AssetHandles.Find(AssetId))
+    {
+        return *Existing;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle;
+    if (UAssetManager::IsInitialized() && UAssetManager::Get().GetPrimaryAssetPath(AssetId).IsValid())
+    {
+        const FStreamableDelegate OnDone = FStreamableDelegate::CreateUObject(this, &UQTableCacheSubsystem::HandleAssetLoaded, AssetId);
+        Handle = UAssetManager::Get().LoadPrimaryAsset(AssetId, TArray<FName>(), OnDone);
+        if (Handle)
+        {
+            Handle->BindCancelDelegate(OnDone);
+        }
+    }
+
+    AssetHandles.Add(AssetId, Handle);
+    return Handle;
+}
+
+void UQTableCacheSubsystem::WhenReady(const FString& Filename, FSimpleDelegate Callback)
+{
+    const FPrimaryAssetId AssetId = GetTableAssetId(Filename);
+
+    // Розібрана таблиця або файл у Saved - ассет FindOrLoad не знадобиться
+    const TSharedPtr<FStreamableHandle> Handle = Tables.Contains(Filename) || FPaths::FileExists(GetTablePath(Filename))
+        ? nullptr : RequestAsset(AssetId);
+
+    if (!Handle || !Handle->IsLoadingInProgress())
+    {
+        Callback.ExecuteIfBound();
+        return;
+    }
+
+    ReadyCallbacks.FindOrAdd(AssetId).Add(MoveTemp(Callback));
+}
+
+void UQTableCacheSubsystem::HandleAssetLoaded(FPrimaryAssetId AssetId)
+{
+    TArray<FSimpleDelegate> Callbacks;
+    if (ReadyCallbacks.RemoveAndCopyValue(AssetId, Callbacks))
+    {
+        for (const FSimpleDelegate& Callback : Callbacks)
+        {
+            Callback.ExecuteIfBound();
+        }
+    }
+}
+
+bool UQTableCacheSubsystem::LoadFromAsset(const FString& Filename, FHighLevelQTable& OutTable)
+{
+    const FPrimaryAssetId AssetId = GetTableAssetId(Filename);
+    if (TSharedPtr<FStreamableHandle> Handle = RequestAsset(AssetId))
+    {
+        // Менеджер спавну чекає WhenReady, тож тут ассет уже завантажений;
+        // блокує хіба що NPC, розставлених на рівні до завершення завантаження
+        Handle->WaitUntilComplete();
+    }
+
+    // Без хендла, якщо ассет був завантажений ще до запиту
+    const UHighLevelQTableAsset* Asset = UAssetManager::IsInitialized()
+        ? UAssetManager::Get().GetPrimaryAssetObject<UHighLevelQTableAsset>(AssetId) : nullptr;
+    return Asset && Asset->ReadTable(OutTable);
+}
+
+const FHighLevelQTable* UQTableCacheSubsystem::FindOrLoad(const FString& Filename)
+{
+    if (const TUniquePtr<FCachedTable>* Cached = Tables.Find(Filename))
+    {
+        return (*Cached)->bValid ? &(*Cached)->Table : nullptr;
+    }
+
+    TUniquePtr<FCachedTable>& Entry = Tables.Add(Filename, MakeUnique<FCachedTable>());
+    Entry->bValid = Entry->Table.LoadFromFile(GetTablePath(Filename));
+
+    if (!Entry->bValid && LoadFromAsset(Filename, Entry->Table))
+    {
+        Entry->bValid = true;
+        UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table cached: %d states from asset %s"),
+               Entry->Table.GetNumStoredStates(), *GetTableAssetId(Filename).ToString());
+    }
+    else if (Entry->bValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("✅ High-Level Q-Table cached: %d states from %s"),
+               Entry->Table.GetNumStoredStates(), *Filename);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not load High-Level Q-Table from: %s"), *GetTablePath(Filename));
+    }
+
+    return Entry->bValid ? &Entry->Table : nullptr;
+}
+
+void UQTableCacheSubsystem::Store(const FString& Filename, const FHighLevelQTable& Table)
+{
+    TUniquePtr<FCachedTable>& Entry = Tables.FindOrAdd(Filename);
+    if (!Entry)
+    {
+        Entry = MakeUnique<FCachedTable>();
+    }
+
+    Entry->Table = Table;
+    Entry->bValid = true;
+}
+
+void UQTableCacheSubsystem::Invalidate(const FString& Filename)
+{
+    Tables.Remove(Filename);
+}
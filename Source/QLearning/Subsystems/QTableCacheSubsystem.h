@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Core/HighLevelQTable.h"
+#include "UObject/PrimaryAssetId.h"
+#include "QTableCacheSubsystem.generated.h"
+
+// Розібрані з JSON високорівневі таблиці на час життя світу.
+// Файл читається один раз, далі NPC копіюють щільну таблицю замість повторного парсингу.
+// Якщо файлу в Saved немає (пакетна збірка), таблиця береться з кукнутого UHighLevelQTableAsset
+// з тим самим іменем; стандартний ассет починає вантажитися асинхронно ще при створенні світу.
+UCLASS()
+class QLEARNING_API UQTableCacheSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // nullptr, якщо файлу немає або він битий (результат теж кешується)
+    const FHighLevelQTable* FindOrLoad(const FString& Filename);
+
+    // Callback, коли FindOrLoad(Filename) вже не чекатиме ассет: файл у Saved є або ассет довантажився.
+    // Якщо чекати нічого - викликається одразу
+    void WhenReady(const FString& Filename, FSimpleDelegate Callback);
+
+    // Викликається після збереження, щоб наступні завантаження бачили свіжі значення
+    void Store(const FString& Filename, const FHighLevelQTable& Table);
+
+    void Invalidate(const FString& Filename);
+
+    static FString GetTablePath(const FString& Filename);
+    static FPrimaryAssetId GetTableAssetId(const FString& Filename);
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    // nullptr, якщо ассета немає в UAssetManager
+    TSharedPtr<struct FStreamableHandle> RequestAsset(const FPrimaryAssetId& AssetId);
+    bool LoadFromAsset(const FString& Filename, FHighLevelQTable& OutTable);
+    void HandleAssetLoaded(FPrimaryAssetId AssetId);
+
+    TMap<FPrimaryAssetId, TSharedPtr<struct FStreamableHandle>> AssetHandles;
+    TMap<FPrimaryAssetId, TArray<FSimpleDelegate>> ReadyCallbacks;
+
+    struct FCachedTable
+    {
+        FHighLevelQTable Table;
+        bool bValid = false;
+    };
+
+    TMap<FString, TUniquePtr<FCachedTable>> Tables;
+};
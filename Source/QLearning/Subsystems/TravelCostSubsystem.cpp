@@ -0,0 +1,365 @@
+#include "TravelCostSubsystem.h"
+#include "InteractableRegistrySubsystem.h"
+#include "../Actors/InteractableObject.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+
+void UTravelCostSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Registry = Collection.InitializeDependency<UInteractableRegistrySubsystem>();
+    if (Registry)
+    {
+        Registry->OnInteractableRegistered.AddUObject(this, &UTravelCostSubsystem::HandleInteractableRegistered);
+        Registry->OnInteractableUnregistered.AddUObject(this, &UTravelCostSubsystem::HandleInteractableUnregistered);
+    }
+}
+
+void UTravelCostSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UTravelCostSubsystem::HandleNavigationGenerationFinished);
+    }
+}
+
+void UTravelCostSubsystem::Deinitialize()
+{
+    if (Registry)
+    {
+        Registry->OnInteractableRegistered.RemoveAll(this);
+        Registry->OnInteractableUnregistered.RemoveAll(this);
+        Registry = nullptr;
+    }
+
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.RemoveAll(this);
+    }
+
+    Nodes.Empty();
+    NodeIndices.Empty();
+    PathLengths.Empty();
+    Stride = 0;
+    NumPending = 0;
+    bHasFallbacks = false;
+
+    Super::Deinitialize();
+}
+
+bool UTravelCostSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTravelCostSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTravelCostSubsystem, STATGROUP_Tickables);
+}
+
+void UTravelCostSubsystem::HandleInteractableRegistered(AInteractableObject* Object)
+{
+    RegisterNode(Object);
+}
+
+void UTravelCostSubsystem::HandleInteractableUnregistered(AInteractableObject* Object)
+{
+    UnregisterNode(Object);
+}
+
+void UTravelCostSubsystem::HandleNavigationGenerationFinished(ANavigationData* NavData)
+{
+    UE_LOG(LogTemp, Log, TEXT("Navmesh rebuilt, invalidating travel cost matrix (%d nodes)"), Nodes.Num());
+    InvalidateAll();
+}
+
+void UTravelCostSubsystem::RegisterNode(AActor* Actor)
+{
+    if (!Actor || NodeIndices.Contains(Actor))
+    {
+        return;
+    }
+
+    FTravelNode Node;
+    Node.Actor = Actor;
+    Node.Key = Actor;
+    Node.Location = Actor->GetActorLocation();
+    if (const AInteractableObject* Object = Cast<AInteractableObject>(Actor))
+    {
+        Node.ActionType = Object->ActionType;
+        Node.bIsInteractable = true;
+    }
+
+    const int32 Index = Nodes.Num();
+    NodeIndices.Add(Actor, Index);
+    Nodes.Add(Node);
+    Reserve(Nodes.Num());
+
+    // Новий вузол - нові рядок і стовпчик, решта матриці лишається як є
+    for (int32 Other = 0; Other < Index; Other++)
+    {
+        PathLengthAt(Index, Other) = -1.0f;
+        PathLengthAt(Other, Index) = -1.0f;
+    }
+    PathLengthAt(Index, Index) = 0.0f;
+    NumPending += 2 * Index;
+}
+
+void UTravelCostSubsystem::UnregisterNode(AActor* Actor)
+{
+    int32 Index = INDEX_NONE;
+    if (!NodeIndices.RemoveAndCopyValue(Actor, Index))
+    {
+        return;
+    }
+
+    // Останній вузол переїжджає на місце видаленого разом зі своїми рядком і стовпчиком
+    const int32 Num = Nodes.Num();
+    const int32 LastIndex = Num - 1;
+    NumPending -= CountPendingInCross(Index, Num);
+
+    if (Index != LastIndex)
+    {
+        NumPending -= CountPendingInCross(LastIndex, Num);
+        NumPending += (PathLengthAt(Index, LastIndex) == -1.0f ? 1 : 0) + (PathLengthAt(LastIndex, Index) == -1.0f ? 1 : 0);
+
+        for (int32 Other = 0; Other < LastIndex; Other++)
+        {
+            if (Other != Index)
+            {
+                PathLengthAt(Index, Other) = PathLengthAt(LastIndex, Other);
+                PathLengthAt(Other, Index) = PathLengthAt(Other, LastIndex);
+            }
+        }
+        PathLengthAt(Index, Index) = 0.0f;
+        NodeIndices.FindChecked(Nodes[LastIndex].Key) = Index;
+    }
+
+    Nodes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    if (Index != LastIndex)
+    {
+        NumPending += CountPendingInCross(Index, Nodes.Num());
+    }
+    ScanCursor = 0;
+}
+
+int32 UTravelCostSubsystem::GetNodeIndex(const AActor* Actor) const
+{
+    const int32* Index = Actor ? NodeIndices.Find(Actor) : nullptr;
+    return Index ? *Index : INDEX_NONE;
+}
+
+void UTravelCostSubsystem::Reserve(int32 MinNodes)
+{
+    if (MinNodes <= Stride)
+    {
+        return;
+    }
+
+    const int32 NewStride = FMath::Max3(MinNodes, Stride * 2, 16);
+    TArray<float> NewLengths;
+    NewLengths.SetNumUninitialized(NewStride * NewStride);
+
+    // Переносимо тільки вже відомі вузли; нові рядки заповнить RegisterNode
+    const int32 NumOld = FMath::Min(Nodes.Num(), Stride);
+    for (int32 From = 0; From < NumOld; From++)
+    {
+        FMemory::Memcpy(&NewLengths[From * NewStride], &PathLengths[From * Stride], NumOld * sizeof(float));
+    }
+
+    PathLengths = MoveTemp(NewLengths);
+    Stride = NewStride;
+}
+
+int32 UTravelCostSubsystem::CountPendingInCross(int32 Node, int32 Num) const
+{
+    int32 Count = 0;
+    for (int32 Other = 0; Other < Num; Other++)
+    {
+        if (Other != Node)
+        {
+            Count += PathLengthAt(Node, Other) == -1.0f ? 1 : 0;
+            Count += PathLengthAt(Other, Node) == -1.0f ? 1 : 0;
+        }
+    }
+    return Count;
+}
+
+void UTravelCostSubsystem::InvalidateAll()
+{
+    const int32 Num = Nodes.Num();
+    for (int32 From = 0; From < Num; From++)
+    {
+        for (int32 To = 0; To < Num; To++)
+        {
+            PathLengthAt(From, To) = From == To ? 0.0f : -1.0f;
+        }
+    }
+    NumPending = Num * (Num - 1);
+    ScanCursor = 0;
+    bHasFallbacks = false;
+}
+
+void UTravelCostSubsystem::RetryFallbacks()
+{
+    const int32 Num = Nodes.Num();
+    for (int32 From = 0; From < Num; From++)
+    {
+        for (int32 To = 0; To < Num; To++)
+        {
+            float& Length = PathLengthAt(From, To);
+            if (Length <= -2.0f)
+            {
+                Length = -1.0f;
+                NumPending++;
+            }
+        }
+    }
+    ScanCursor = 0;
+    bHasFallbacks = false;
+}
+
+bool UTravelCostSubsystem::ComputePathLength(int32 FromNode, int32 ToNode, float& OutLength) const
+{
+    const FVector& Start = Nodes[FromNode].Location;
+    const FVector& End = Nodes[ToNode].Location;
+
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        FVector::FReal Length = 0.0;
+        if (NavSys->GetPathLength(Start, End, Length) == ENavigationQueryResult::Success)
+        {
+            OutLength = (float)Length;
+            return true;
+        }
+    }
+
+    OutLength = FVector::Dist(Start, End);
+    return false;
+}
+
+void UTravelCostSubsystem::Tick(float DeltaTime)
+{
+    if (NumPending == 0)
+    {
+        // Навмеш міг довантажитись без повної перебудови - непораховані пари перепитуємо зрідка
+        if (bHasFallbacks && FPlatformTime::Seconds() >= NextFallbackRetryTime)
+        {
+            RetryFallbacks();
+        }
+
+        if (NumPending == 0)
+        {
+            return;
+        }
+    }
+
+    const int32 Num = Nodes.Num();
+    const int32 Total = Num * Num;
+    int32 Queries = 0;
+    ScanCursor = ScanCursor < Total ? ScanCursor : 0;
+
+    for (int32 Visited = 0; Visited < Total && Queries < MaxPathQueriesPerTick; Visited++)
+    {
+        const int32 From = ScanCursor / Num;
+        const int32 To = ScanCursor % Num;
+        ScanCursor = (ScanCursor + 1) % Total;
+
+        if (PathLengthAt(From, To) != -1.0f)
+        {
+            continue;
+        }
+
+        float Length = 0.0f;
+        const bool bFound = ComputePathLength(From, To, Length);
+        const float Stored = bFound ? Length : -Length - 2.0f;
+        Queries++;
+
+        if (!bFound && !bHasFallbacks)
+        {
+            bHasFallbacks = true;
+            NextFallbackRetryTime = FPlatformTime::Seconds() + FallbackRetryInterval;
+        }
+
+        // Вважаємо шлях симетричним
+        PathLengthAt(From, To) = Stored;
+        NumPending--;
+
+        float& Reverse = PathLengthAt(To, From);
+        if (Reverse == -1.0f)
+        {
+            Reverse = Stored;
+            NumPending--;
+        }
+    }
+
+    if (NumPending == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Travel cost matrix complete: %d nodes"), Num);
+    }
+}
+
+float UTravelCostSubsystem::GetPathLength(int32 FromNode, int32 ToNode) const
+{
+    if (!Nodes.IsValidIndex(FromNode) || !Nodes.IsValidIndex(ToNode))
+    {
+        return TNumericLimits<float>::Max();
+    }
+
+    const float Length = PathLengthAt(FromNode, ToNode);
+    if (Length >= 0.0f)
+    {
+        return Length;
+    }
+    return Length <= -2.0f ? -Length - 2.0f : FVector::Dist(Nodes[FromNode].Location, Nodes[ToNode].Location);
+}
+
+float UTravelCostSubsystem::GetTravelTime(int32 FromNode, int32 ToNode, float Speed) const
+{
+    return GetPathLength(FromNode, ToNode) / FMath::Max(Speed, 1.0f);
+}
+
+AInteractableObject* UTravelCostSubsystem::FindBestFreeObject(EActionType ActionType, const AActor* FromNode,
+                                                              float* OutPathLength) const
+{
+    const int32 From = GetNodeIndex(FromNode);
+    if (From == INDEX_NONE || !Registry || ActionType >= EActionType::MAX)
+    {
+        return nullptr;
+    }
+
+    AInteractableObject* Best = nullptr;
+    float BestLength = TNumericLimits<float>::Max();
+
+    // Кандидати - тільки об'єкти потрібного типу з реєстру, а не всі вузли матриці
+    for (AInteractableObject* Object : Registry->GetInteractables(ActionType))
+    {
+        if (!IsValid(Object) || !Object->CanInteract())
+        {
+            continue;
+        }
+
+        const int32 To = GetNodeIndex(Object);
+        if (To == INDEX_NONE)
+        {
+            continue;
+        }
+
+        const float Length = GetPathLength(From, To);
+        if (Length < BestLength)
+        {
+            BestLength = Length;
+            Best = Object;
+        }
+    }
+
+    if (OutPathLength)
+    {
+        *OutPathLength = BestLength;
+    }
+    return Best;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../Core/QLearningTypes.h"
+#include "TravelCostSubsystem.generated.h"
+
+class AInteractableObject;
+class ANavigationData;
+
+// Кеш довжин шляхів по навмешу між усіма інтерактивними об'єктами та точками спавну.
+// Матриця добудовується поступово в Tick, інвалідовується при зміні вузлів і перебудовується після генерації навмешу.
+// Пари, для яких навігація не знайшла шлях, тримають пряму відстань і перепитуються раз на FallbackRetryInterval.
+UCLASS()
+class QLEARNING_API UTravelCostSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterNode(AActor* Actor);
+    void UnregisterNode(AActor* Actor);
+    int32 GetNodeIndex(const AActor* Actor) const;
+
+    // Довжина шляху; поки значення не пораховане - пряма відстань
+    float GetPathLength(int32 FromNode, int32 ToNode) const;
+    float GetTravelTime(int32 FromNode, int32 ToNode, float Speed) const;
+
+    // Вільний об'єкт потрібного типу з найменшою довжиною шляху від вузла
+    AInteractableObject* FindBestFreeObject(EActionType ActionType, const AActor* FromNode,
+                                            float* OutPathLength = nullptr) const;
+
+    void InvalidateAll();
+    bool IsComplete() const { return NumPending == 0; }
+
+    // Скільки синхронних запитів до навігації робити за кадр
+    int32 MaxPathQueriesPerTick = 32;
+
+    // Як часто перепитувати навігацію для пар, що зараз на прямій відстані
+    float FallbackRetryInterval = 5.0f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FTravelNode
+    {
+        TWeakObjectPtr<AActor> Actor;
+        const AActor* Key = nullptr;
+        FVector Location = FVector::ZeroVector;
+        EActionType ActionType = EActionType::Idle;
+        bool bIsInteractable = false;
+    };
+
+    UFUNCTION()
+    void HandleNavigationGenerationFinished(ANavigationData* NavData);
+
+    void HandleInteractableRegistered(AInteractableObject* Object);
+    void HandleInteractableUnregistered(AInteractableObject* Object);
+
+    void Reserve(int32 MinNodes);
+    int32 CountPendingInCross(int32 Node, int32 Num) const;
+    void RetryFallbacks();
+    bool ComputePathLength(int32 FromNode, int32 ToNode, float& OutLength) const;
+
+    float& PathLengthAt(int32 FromNode, int32 ToNode) { return PathLengths[FromNode * Stride + ToNode]; }
+    float PathLengthAt(int32 FromNode, int32 ToNode) const { return PathLengths[FromNode * Stride + ToNode]; }
+
+    class UInteractableRegistrySubsystem* Registry = nullptr;
+
+    TArray<FTravelNode> Nodes;
+    TMap<const AActor*, int32> NodeIndices;
+
+    // [From * Stride + To], Stride росте вдвічі, тож реєстрація вузла не перевиділяє матрицю щоразу.
+    // >= 0 - довжина по навмешу, -1 - ще не пораховано, <= -2 - пряма відстань (-Length - 2), бо шляху не знайшлося
+    TArray<float> PathLengths;
+    int32 Stride = 0;
+    int32 NumPending = 0;
+    int32 ScanCursor = 0;
+    bool bHasFallbacks = false;
+    double NextFallbackRetryTime = 0.0;
+};
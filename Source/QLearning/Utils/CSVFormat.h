@@ -0,0 +1,9 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Число для CSV-логів: завжди з крапкою, бо колонки розділяються ';' і файли читають скрипти
+inline FString FormatCSVFloat(double Value)
+{
+    return FString::SanitizeFloat(Value).Replace(TEXT(","), TEXT("."));
+}
@@ -1,4 +1,5 @@
 #include "CSVLogger.h"
+#include "CSVFormat.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
@@ -6,6 +7,11 @@
 
 FString UCSVLogger::CurrentLogFilePath = TEXT("");
 
+namespace
+{
+    const TCHAR* CSVLogHeader = TEXT("Timestamp;NPCID;Generation;Action;StateKey;Reward;Lifetime;Event;Hunger;Bladder;Energy;Social;Hygiene;Fun;Duration");
+}
+
 void UCSVLogger::InitializeLog()
 {
     if (CurrentLogFilePath.IsEmpty())
@@ -20,10 +26,18 @@ void UCSVLogger::InitializeLog()
         PlatformFile.CreateDirectory(*Directory);
     }
     
+    // Файл зі старим набором колонок відкладаємо вбік, щоб рядки різного формату не змішались
+    if (FPaths::FileExists(CurrentLogFilePath) && ReadFirstLine(CurrentLogFilePath) != CSVLogHeader)
+    {
+        const FString RotatedPath = FPaths::GetBaseFilename(CurrentLogFilePath, false) + 
+            FDateTime::Now().ToString(TEXT("_%Y%m%d_%H%M%S")) + TEXT(".csv");
+        IFileManager::Get().Move(*RotatedPath, *CurrentLogFilePath);
+        UE_LOG(LogTemp, Warning, TEXT("CSV Log header changed, old log moved to: %s"), *RotatedPath);
+    }
+    
     if (!FPaths::FileExists(CurrentLogFilePath))
     {
-        FString Header = TEXT("Timestamp;NPCID;Generation;Action;StateKey;Reward;Lifetime;Event;Hunger;Bladder;Energy;Social;Hygiene;Fun\n");
-        FFileHelper::SaveStringToFile(Header, *CurrentLogFilePath);
+        FFileHelper::SaveStringToFile(FString(CSVLogHeader) + TEXT("\n"), *CurrentLogFilePath);
         UE_LOG(LogTemp, Log, TEXT("CSV Log initialized at: %s"), *CurrentLogFilePath);
     }
     else
@@ -34,7 +48,7 @@ void UCSVLogger::InitializeLog()
 
 void UCSVLogger::LogAction(int32 NPCID, int32 Generation, EActionType Action,
                           const FString& StateKey, float Reward, float Lifetime,
-                          const TMap<ENeedType, float>& Needs)
+                          const TMap<ENeedType, float>& Needs, float Duration)
 {
     if (CurrentLogFilePath.IsEmpty())
     {
@@ -42,10 +56,12 @@ void UCSVLogger::LogAction(int32 NPCID, int32 Generation, EActionType Action,
     }
     
     // ВИПРАВЛЕНО: Форматуємо числа з крапкою
-    FString RewardStr = FString::SanitizeFloat(Reward).Replace(TEXT(","), TEXT("."));
-    FString LifetimeStr = FString::SanitizeFloat(Lifetime).Replace(TEXT(","), TEXT("."));
+    FString RewardStr = FormatCSVFloat(Reward);
+    FString LifetimeStr = FormatCSVFloat(Lifetime);
+    FString DurationStr = FormatCSVFloat(Duration);
     
-    FString Line = FString::Printf(TEXT("%s;%d;%d;%d;%s;%s;%s;Action;%s\n"),
+    // Duration - остання колонка, щоб старі скрипти з індексами колонок не зламались
+    FString Line = FString::Printf(TEXT("%s;%d;%d;%d;%s;%s;%s;Action;%s;%s\n"),
         *GetTimestamp(),
         NPCID,
         Generation,
@@ -53,7 +69,8 @@ void UCSVLogger::LogAction(int32 NPCID, int32 Generation, EActionType Action,
         *StateKey,
         *RewardStr,
         *LifetimeStr,
-        *NeedMapToString(Needs)
+        *NeedMapToString(Needs),
+        *DurationStr
     );
 
     FFileHelper::SaveStringToFile(Line, *CurrentLogFilePath, 
@@ -63,7 +80,7 @@ void UCSVLogger::LogAction(int32 NPCID, int32 Generation, EActionType Action,
 }
 
 void UCSVLogger::LogDeath(int32 NPCID, int32 Generation, float Lifetime,
-                         const TMap<ENeedType, float>& Needs)
+                         const TMap<ENeedType, float>& Needs, float Duration)
 {
     if (CurrentLogFilePath.IsEmpty())
     {
@@ -71,16 +88,18 @@ void UCSVLogger::LogDeath(int32 NPCID, int32 Generation, float Lifetime,
     }
     
     // ВИПРАВЛЕНО: Форматуємо числа з крапкою
-    FString LifetimeStr = FString::SanitizeFloat(Lifetime).Replace(TEXT(","), TEXT("."));
+    FString LifetimeStr = FormatCSVFloat(Lifetime);
+    FString DurationStr = FormatCSVFloat(Duration);
     
-    FString Line = FString::Printf(TEXT("%s;%d;%d;%d;%s;-1000.00;%s;Death;%s\n"),
+    FString Line = FString::Printf(TEXT("%s;%d;%d;%d;%s;-1000.00;%s;Death;%s;%s\n"),
         *GetTimestamp(),
         NPCID,
         Generation,
         -1,
         TEXT("N/A"),
         *LifetimeStr,
-        *NeedMapToString(Needs)
+        *NeedMapToString(Needs),
+        *DurationStr
     );
 
     FFileHelper::SaveStringToFile(Line, *CurrentLogFilePath, 
@@ -99,6 +118,31 @@ FString UCSVLogger::GetLogFilePath()
     return CurrentLogFilePath;
 }
 
+FString UCSVLogger::ReadFirstLine(const FString& FilePath)
+{
+    // Лог може бути великим - читаємо тільки початок
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        return FString();
+    }
+
+    TArray<uint8> Bytes;
+    Bytes.SetNumUninitialized((int32)FMath::Min<int64>(Reader->TotalSize(), 1024));
+    Reader->Serialize(Bytes.GetData(), Bytes.Num());
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+    FString Head(Converted.Length(), Converted.Get());
+
+    FString FirstLine;
+    if (!Head.Split(TEXT("\n"), &FirstLine, nullptr))
+    {
+        FirstLine = Head;
+    }
+    FirstLine.TrimEndInline();
+    return FirstLine;
+}
+
 FString UCSVLogger::GetTimestamp()
 {
     return FDateTime::Now().ToString(TEXT("%Y-%m-%d_%H:%M:%S"));
@@ -119,12 +163,12 @@ FString UCSVLogger::NeedMapToString(const TMap<ENeedType, float>& Needs)
     }
 
     // ВИПРАВЛЕНО: Кожне число окремо з заміною коми на крапку
-    FString V0 = FString::SanitizeFloat(Values[0]).Replace(TEXT(","), TEXT("."));
-    FString V1 = FString::SanitizeFloat(Values[1]).Replace(TEXT(","), TEXT("."));
-    FString V2 = FString::SanitizeFloat(Values[2]).Replace(TEXT(","), TEXT("."));
-    FString V3 = FString::SanitizeFloat(Values[3]).Replace(TEXT(","), TEXT("."));
-    FString V4 = FString::SanitizeFloat(Values[4]).Replace(TEXT(","), TEXT("."));
-    FString V5 = FString::SanitizeFloat(Values[5]).Replace(TEXT(","), TEXT("."));
+    FString V0 = FormatCSVFloat(Values[0]);
+    FString V1 = FormatCSVFloat(Values[1]);
+    FString V2 = FormatCSVFloat(Values[2]);
+    FString V3 = FormatCSVFloat(Values[3]);
+    FString V4 = FormatCSVFloat(Values[4]);
+    FString V5 = FormatCSVFloat(Values[5]);
 
     return FString::Printf(TEXT("%s;%s;%s;%s;%s;%s"),
         *V0, *V1, *V2, *V3, *V4, *V5);
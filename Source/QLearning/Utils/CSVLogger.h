@@ -17,17 +17,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Logging")
 	static void LogAction(int32 NPCID, int32 Generation, EActionType Action, 
 						 const FString& StateKey, float Reward, float Lifetime,
-						 const TMap<ENeedType, float>& Needs);
+						 const TMap<ENeedType, float>& Needs, float Duration = 0.0f);
 
 	UFUNCTION(BlueprintCallable, Category = "Logging")
 	static void LogDeath(int32 NPCID, int32 Generation, float Lifetime,
-						const TMap<ENeedType, float>& Needs);
+						const TMap<ENeedType, float>& Needs, float Duration = 0.0f);
 
 	UFUNCTION(BlueprintCallable, Category = "Logging")
 	static void SaveLog();
 
 private:
 	static FString GetLogFilePath();
+	static FString ReadFirstLine(const FString& FilePath);
 	static FString GetTimestamp();
 	static FString NeedMapToString(const TMap<ENeedType, float>& Needs);
 
@@ -8,6 +8,35 @@ float UGenerationLogger::TotalLifetime = 0.0f;
 float UGenerationLogger::BestLifetime = 0.0f;
 int32 UGenerationLogger::BestGeneration = 0;
 FString UGenerationLogger::CurrentLogFilePath = TEXT("");
+FRollingLifetimeStats UGenerationLogger::RollingLifetime(UGenerationLogger::RollingWindowSize);
+
+FRollingLifetimeStats::FRollingLifetimeStats(int32 InWindowSize)
+    : WindowSize(FMath::Max(InWindowSize, 1))
+{
+    Window.Reserve(WindowSize);
+}
+
+void FRollingLifetimeStats::Add(float Lifetime)
+{
+    if (Window.Num() < WindowSize)
+    {
+        Window.Add(Lifetime);
+    }
+    else
+    {
+        Sum -= Window[Head];
+        Window[Head] = Lifetime;
+        Head = (Head + 1) % WindowSize;
+    }
+    Sum += Lifetime;
+}
+
+void FRollingLifetimeStats::Reset()
+{
+    Window.Reset();
+    Head = 0;
+    Sum = 0.0;
+}
 
 void UGenerationLogger::InitializeGenerationLog()
 {
@@ -70,6 +99,7 @@ void UGenerationLogger::LogGeneration(const FGenerationStats& Stats)
     
     TotalGenerations++;
     TotalLifetime += Stats.Lifetime;
+    RollingLifetime.Add(Stats.Lifetime);
 
     if (Stats.Lifetime > BestLifetime)
     {
@@ -81,6 +111,7 @@ void UGenerationLogger::LogGeneration(const FGenerationStats& Stats)
     UE_LOG(LogTemp, Warning, TEXT("Lifetime: %.2f seconds"), Stats.Lifetime);
     UE_LOG(LogTemp, Warning, TEXT("Cause of Death: Need %d"), (int32)Stats.CauseOfDeath);
     UE_LOG(LogTemp, Warning, TEXT("Average Lifetime: %.2f seconds"), TotalLifetime / TotalGenerations);
+    UE_LOG(LogTemp, Warning, TEXT("Rolling Average (last %d): %.2f seconds"), RollingLifetime.Num(), RollingLifetime.GetMean());
     UE_LOG(LogTemp, Warning, TEXT("Best: Gen %d with %.2f seconds"), BestGeneration, BestLifetime);
 }
 
@@ -94,6 +125,11 @@ void UGenerationLogger::LogSummary()
     UE_LOG(LogTemp, Warning, TEXT("================================"));
 }
 
+float UGenerationLogger::GetRollingAverageLifetime()
+{
+    return RollingLifetime.GetMean();
+}
+
 FString UGenerationLogger::GetGenerationLogPath()
 {
     return CurrentLogFilePath;
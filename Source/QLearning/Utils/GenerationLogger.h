@@ -32,6 +32,26 @@ struct FGenerationStats
 	FString Timestamp;
 };
 
+// Ковзне середнє тривалості життя за останні WindowSize смертей
+struct QLEARNING_API FRollingLifetimeStats
+{
+	explicit FRollingLifetimeStats(int32 InWindowSize = 50);
+
+	void Add(float Lifetime);
+	void Reset();
+
+	float GetMean() const { return Window.Num() > 0 ? (float)(Sum / Window.Num()) : 0.0f; }
+	int32 Num() const { return Window.Num(); }
+	int32 GetWindowSize() const { return WindowSize; }
+	bool IsFull() const { return Window.Num() == WindowSize; }
+
+private:
+	TArray<float> Window;
+	int32 WindowSize = 50;
+	int32 Head = 0;
+	double Sum = 0.0;
+};
+
 UCLASS()
 class QLEARNING_API UGenerationLogger : public UBlueprintFunctionLibrary
 {
@@ -49,12 +69,19 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	static int32 GetLastGeneration();
+
+	// Середнє за останні RollingWindowSize поколінь цього запуску
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+	static float GetRollingAverageLifetime();
+
+	static constexpr int32 RollingWindowSize = 50;
 private:
 	static FString GetGenerationLogPath();
 	static int32 TotalGenerations;
 	static float TotalLifetime;
 	static float BestLifetime;
 	static int32 BestGeneration;
+	static FRollingLifetimeStats RollingLifetime;
 
 	static FString CurrentLogFilePath; 
 };
\ No newline at end of file